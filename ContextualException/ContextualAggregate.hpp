@@ -0,0 +1,254 @@
+#ifndef __CONTEXTUAL_AGGREGATE_HPP__
+#define __CONTEXTUAL_AGGREGATE_HPP__
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "ContextualException.hpp"
+
+// 병렬 작업의 실패를 모아 하나의 ContextualException 으로 만듦
+// - 작업 스레드는 락 없이 Add (실패한 작업만 원자적 연산 수행,
+//   실패가 없으면 동기화 없음)
+// - 먼저 들어온 keep_first 개는 예외 전체를 보관, 모든 실패는 code 별로 집계
+// - Materialize: 기본 프레임 "N failures" 아래에 보관한 실패마다
+//   "failure i/N" 프레임 하나와 그 실패의 체인 전체(AddFrames)를 차례로 붙임
+//   (체인은 선형이므로 실패 사이의 경계는 "failure i/N" 프레임,
+//    보관하지 못한 실패가 있으면 "failures with code=C: K" 프레임을 덧붙임)
+// usecase)
+//   contextual_exception::ExceptionCollector collector(8);
+//   parallel_for(tasks, [&](Task& task) {
+//       try {
+//           task.Run();
+//       } catch (const std::exception& exception) {
+//           collector.Add(exception);
+//       }
+//   });
+//   collector.ThrowIfFailed(*CONTEXTUAL_SOURCE_SITE());
+
+namespace contextual_exception {
+namespace anonymous {
+
+// 기본 프레임의 code 만 확인하는 FrameSink
+class BaseCodeSink : public FrameSink {
+   public:
+    BaseCodeSink() : code_(0), found_(false) {}
+
+    virtual void AddFrame(const char* message, int code,
+                          const SourceSite& site) override {
+        (void)message;
+        (void)site;
+        SetCode(code);
+    }
+    virtual void AddFrames(const ::ContextualException& exception) override {
+        SetCode(exception.Code());
+    }
+
+    int Code() const {
+        return code_;
+    }
+
+   private:
+    void SetCode(int code) {
+        if (!found_) {
+            code_ = code;
+            found_ = true;
+        }
+    }
+
+    int code_;
+    bool found_;
+};
+
+}  // namespace anonymous
+
+class ExceptionCollector {
+   public:
+    // code 별 집계 슬롯 수 (넘치는 code 는 OtherCodeCount 로 합산)
+    enum { kCodeSlots = 16 };
+
+    explicit ExceptionCollector(std::size_t keep_first = 8)
+        : keep_first_(keep_first),
+          kept_(new Kept[keep_first]),
+          failure_count_(0),
+          other_codes_(0) {}
+    ExceptionCollector(const ExceptionCollector&) = delete;
+    ExceptionCollector& operator=(const ExceptionCollector&) = delete;
+
+    // 작업 스레드에서 호출 (락 없음)
+    // - ContextualException 은 체인을 공유하므로 복사 비용 O(1)
+    template <typename Source,
+              typename = anonymous::EnableIfFrameSource<Source>>
+    void Add(const Source& exception) {
+        const std::uint64_t index =
+            failure_count_.fetch_add(1, std::memory_order_relaxed);
+        if (index < keep_first_) {
+            kept_[index].exception =
+                ::ContextualException::FromSource(exception);
+            kept_[index].ready.store(true, std::memory_order_release);
+        }
+        anonymous::BaseCodeSink sink;
+        exception.VisitFrames(&sink);
+        CountCode(sink.Code());
+    }
+    // FrameSource 가 아니면 what() 을 메시지로 하는 위치 정보 없는 프레임
+    // (작업 스레드의 CONTEXTUAL_SCOPE 범위는 붙이지 않음)
+    void Add(const std::exception& exception) {
+        const FrameSource* source = anonymous::AsFrameSource(exception);
+        if (source) {
+            Add<FrameSource>(*source);
+            return;
+        }
+        typedef ::ContextualException::Frame Frame;
+        static const SourceSite unknown_site = {"", "", 0, nullptr};
+        const int default_code = 0;
+        Add(::ContextualException::FromFrames(std::vector<Frame>(
+            1, Frame(exception.what(), default_code, unknown_site))));
+    }
+
+    bool Failed() const {
+        return 0 != FailureCount();
+    }
+    std::uint64_t FailureCount() const {
+        return failure_count_.load(std::memory_order_relaxed);
+    }
+    // 보관된 실패 (모든 작업이 끝난 뒤 조회)
+    std::vector<::ContextualException> Failures() const {
+        std::vector<::ContextualException> failures;
+        for (std::size_t ii = 0; ii < KeptCount(); ++ii) {
+            if (kept_[ii].ready.load(std::memory_order_acquire)) {
+                failures.push_back(kept_[ii].exception);
+            }
+        }
+        return failures;
+    }
+    // ii 번째 code 슬롯 (비어 있으면 false)
+    bool CodeCount(std::size_t ii, int* code, std::uint64_t* count) const {
+        const std::uint64_t key =
+            codes_[ii].key.load(std::memory_order_acquire);
+        if (0 == key) {
+            return false;
+        }
+        *code = static_cast<int>(static_cast<std::uint32_t>(key));
+        *count = codes_[ii].count.load(std::memory_order_relaxed);
+        return true;
+    }
+    std::uint64_t OtherCodeCount() const {
+        return other_codes_.load(std::memory_order_relaxed);
+    }
+
+    // 보관한 실패마다 "failure i/N" 프레임과 그 실패의 체인을 가진 예외
+    // (모든 작업이 끝난 뒤 호출)
+    ::ContextualException Materialize(const SourceSite& site) const {
+        return ::ContextualException::FromSource(Materialized(*this, site));
+    }
+
+    // 실패가 있으면 Materialize 결과를 throw
+    void ThrowIfFailed(const SourceSite& site) const {
+        if (CONTEXTUAL_UNLIKELY(Failed())) {
+            throw Materialize(site);
+        }
+    }
+
+   private:
+    // Materialize 의 프레임을 차례로 넘기는 FrameSource
+    // (실패의 체인은 AddFrames 로 넘겨 마지막 실패 뒤에 프레임이 없으면 공유)
+    class Materialized : public FrameSource {
+       public:
+        Materialized(const ExceptionCollector& collector,
+                     const SourceSite& site)
+            : collector_(collector), site_(site) {}
+
+        virtual void VisitFrames(FrameSink* sink) const override {
+            const int default_code = 0;
+            const std::uint64_t failure_count = collector_.FailureCount();
+            const std::string total = std::to_string(failure_count);
+            const std::vector<::ContextualException> failures =
+                collector_.Failures();
+
+            sink->AddFrame((total + " failures").c_str(), default_code, site_);
+            for (std::size_t ii = 0; ii < failures.size(); ++ii) {
+                const std::string message =
+                    "failure " + std::to_string(ii + 1) + "/" + total;
+                sink->AddFrame(message.c_str(), default_code, site_);
+                sink->AddFrames(failures[ii]);
+            }
+            if (failures.size() == failure_count) {
+                return;
+            }
+            for (std::size_t ii = 0; ii < kCodeSlots; ++ii) {
+                int code = 0;
+                std::uint64_t count = 0;
+                if (collector_.CodeCount(ii, &code, &count)) {
+                    const std::string message =
+                        "failures with code=" + std::to_string(code) + ": " +
+                        std::to_string(count);
+                    sink->AddFrame(message.c_str(), code, site_);
+                }
+            }
+            if (0 != collector_.OtherCodeCount()) {
+                const std::string message =
+                    "failures with other codes: " +
+                    std::to_string(collector_.OtherCodeCount());
+                sink->AddFrame(message.c_str(), default_code, site_);
+            }
+        }
+
+       private:
+        const ExceptionCollector& collector_;
+        const SourceSite& site_;
+    };
+
+    struct Kept {
+        ::ContextualException exception;
+        std::atomic<bool> ready;
+
+        Kept() : ready(false) {}
+    };
+    struct CodeSlot {
+        // 0: 비어 있음, 1<<32 | code
+        std::atomic<std::uint64_t> key;
+        std::atomic<std::uint64_t> count;
+
+        CodeSlot() : key(0), count(0) {}
+    };
+
+    std::size_t KeptCount() const {
+        const std::uint64_t failure_count = FailureCount();
+        return failure_count < keep_first_
+                   ? static_cast<std::size_t>(failure_count)
+                   : keep_first_;
+    }
+
+    void CountCode(int code) {
+        const std::uint64_t key = (static_cast<std::uint64_t>(1) << 32) |
+                                  static_cast<std::uint32_t>(code);
+        for (CodeSlot& slot : codes_) {
+            std::uint64_t current = slot.key.load(std::memory_order_acquire);
+            // 실패하면 current 는 먼저 채운 스레드의 값
+            if (0 == current && slot.key.compare_exchange_strong(
+                                    current, key, std::memory_order_acq_rel)) {
+                current = key;
+            }
+            if (key == current) {
+                slot.count.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+        }
+        other_codes_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    const std::size_t keep_first_;
+    const std::unique_ptr<Kept[]> kept_;
+    std::atomic<std::uint64_t> failure_count_;
+    CodeSlot codes_[kCodeSlots];
+    std::atomic<std::uint64_t> other_codes_;
+};
+
+}  // namespace contextual_exception
+
+#endif  //__CONTEXTUAL_AGGREGATE_HPP__
@@ -0,0 +1,170 @@
+#ifndef __CONTEXTUAL_COROUTINE_HPP__
+#define __CONTEXTUAL_COROUTINE_HPP__
+
+#include <type_traits>
+#include <utility>
+
+#if defined(__has_include)
+#if __has_include(<coroutine>) && \
+    (__cplusplus >= 202002L || (defined(_MSVC_LANG) && _MSVC_LANG >= 202002L))
+#include <coroutine>
+#endif
+#endif
+
+#include "ContextualException.hpp"
+
+// co_await 경계를 지날 때마다 기다리던 코루틴의 위치를 프레임으로 추가
+// - throw 지점의 __FUNCTION__ 은 await_resume, 람다 등이므로 논리적인
+//   비동기 호출 경로를 co_await 지점 프레임으로 남김
+//   (바깥 코루틴의 co_await 가 위쪽 프레임)
+// - 실패하지 않으면 할당 없음 (awaiter 에 위치 정보만 보관)
+// - 프레임은 AddContext 와 같이 기본 프레임으로 추가 (체인 공유, O(1))하고
+//   code 는 원래 기본 프레임의 code 를 유지
+// - awaitable 이 내보낸 예외 객체는 바꾸지 않고 복사본(체인 공유)에 추가해
+//   던지므로 같은 예외를 여러 코루틴이 기다려도 (shared task 등) 각자의
+//   프레임만 붙음
+// - CONTEXTUAL_SCOPE 는 co_await 를 사이에 두면 안 됨 (범위 스택은 스레드별이라
+//   중단 중에 다른 코루틴, 다른 스레드의 범위와 섞임, 디버그 빌드에서 해제 시
+//   assert), 중단 지점을 넘는 컨텍스트는 CONTEXTUAL_AWAIT 프레임으로 남길 것
+//   { CONTEXTUAL_SCOPE("shard {}", id); Parse(); }   // OK
+//   co_await CONTEXTUAL_AWAIT(Fetch(id));             // OK
+// usecase 1) promise 에 섞어 모든 co_await 에 적용 (C++20 source_location)
+//   struct Task::promise_type : contextual_exception::ContextualPromise {
+//       ...
+//   };
+// usecase 2) promise 를 바꿀 수 없는 코루틴 타입
+//   User user = co_await CONTEXTUAL_AWAIT(FetchUser(id));
+//   // "a.cpp:42 | Handle() | co_await FetchUser(id)"
+
+#if defined(__cpp_impl_coroutine) && defined(__cpp_lib_coroutine)
+
+namespace contextual_exception {
+namespace anonymous {
+
+// awaitable 의 awaiter (operator co_await 가 있으면 그 결과)
+template <typename Awaitable>
+decltype(auto) GetAwaiter(Awaitable&& awaitable) {
+    if constexpr (requires {
+                      std::forward<Awaitable>(awaitable).operator co_await();
+                  }) {
+        return std::forward<Awaitable>(awaitable).operator co_await();
+    } else if constexpr (requires {
+                             operator co_await(
+                                 std::forward<Awaitable>(awaitable));
+                         }) {
+        return operator co_await(std::forward<Awaitable>(awaitable));
+    } else {
+        return std::forward<Awaitable>(awaitable);
+    }
+}
+
+// CONTEXTUAL_AWAIT 의 정적 위치 정보
+struct StaticAwaitSite {
+    const SourceSite* site;
+    // "co_await <식>" 리터럴
+    const char* message;
+
+    const SourceSite& Site() const {
+        return *site;
+    }
+    const char* Message() const {
+        return message;
+    }
+};
+
+#if defined(__cpp_lib_source_location)
+// ContextualPromise 의 위치 정보 (실패 시에만 InternSourceSite 로 등록)
+struct LocationAwaitSite {
+    std::source_location location;
+
+    const SourceSite& Site() const {
+        return InternSourceSite(location);
+    }
+    const char* Message() const {
+        return "co_await";
+    }
+};
+#endif
+
+// awaiter 를 감싸 await_resume 이 내보낸 ContextualException 의 복사본에
+// 프레임을 추가해 던짐
+// (awaitable 과 그 awaiter 는 co_await 식이 끝날 때까지 유효)
+template <typename Awaiter, typename AwaitSite>
+class ContextualAwaiter {
+   public:
+    ContextualAwaiter(Awaiter&& awaiter, const AwaitSite& site)
+        : awaiter_(std::forward<Awaiter>(awaiter)), site_(site) {}
+
+    bool await_ready() {
+        return awaiter_.await_ready();
+    }
+    template <typename Promise>
+    decltype(auto) await_suspend(std::coroutine_handle<Promise> handle) {
+        return awaiter_.await_suspend(handle);
+    }
+    decltype(auto) await_resume() {
+        try {
+            return static_cast<Awaiter&&>(awaiter_).await_resume();
+        } catch (const ::ContextualException& exception) {
+            Rethrow(exception);
+        }
+#if defined(CONTEXTUAL_EXCEPTION_USE_FIXED_CAPACITY)
+        catch (const Exception& exception) {
+            Rethrow(exception);
+        }
+#endif
+    }
+
+   private:
+    template <typename Exception>
+    [[noreturn]] CONTEXTUAL_EXCEPTION_COLD void Rethrow(
+        const Exception& exception) const {
+        Exception copy(exception);
+        copy.AddContext(site_.Message(), copy.Code(), site_.Site());
+        throw copy;
+    }
+
+   private:
+    Awaiter awaiter_;
+    AwaitSite site_;
+};
+
+template <typename AwaitSite, typename Awaitable>
+auto MakeContextualAwaiter(Awaitable&& awaitable, const AwaitSite& site) {
+    typedef decltype(GetAwaiter(std::forward<Awaitable>(awaitable))) Awaiter;
+    return ContextualAwaiter<Awaiter, AwaitSite>(
+        GetAwaiter(std::forward<Awaitable>(awaitable)), site);
+}
+
+}  // namespace anonymous
+
+#if defined(__cpp_lib_source_location)
+// 코루틴 promise 에 섞는 기반 클래스
+// - 모든 co_await 를 감싸 co_await 위치 프레임을 추가
+// - promise 에 다른 await_transform 이 있으면 이 await_transform 을 가리므로
+//   그 안에서 직접 호출할 것
+class ContextualPromise {
+   public:
+    template <typename Awaitable>
+    auto await_transform(Awaitable&& awaitable,
+                         const std::source_location location =
+                             std::source_location::current()) {
+        const anonymous::LocationAwaitSite site = {location};
+        return anonymous::MakeContextualAwaiter(
+            std::forward<Awaitable>(awaitable), site);
+    }
+};
+#endif
+
+}  // namespace contextual_exception
+
+// awaitable 을 감싸 co_await 위치 프레임 추가 (co_await 의 피연산자로 사용)
+#define CONTEXTUAL_AWAIT(...)                                 \
+    ::contextual_exception::anonymous::MakeContextualAwaiter( \
+        (__VA_ARGS__),                                        \
+        ::contextual_exception::anonymous::StaticAwaitSite{   \
+            __CONTEXTUAL_FUNCTION_SOURCE_SITE(), "co_await " #__VA_ARGS__})
+
+#endif
+
+#endif  //__CONTEXTUAL_COROUTINE_HPP__
@@ -0,0 +1,248 @@
+#ifndef __CONTEXTUAL_CRASH_REPORT_HPP__
+#define __CONTEXTUAL_CRASH_REPORT_HPP__
+
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <exception>
+
+#if defined(_WIN32)
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+#include "ContextualException.hpp"
+
+// 힙 상태와 무관한 크래시 진단 출력
+// - 할당, 락, 스트림 없이 비동기 시그널 안전 함수(write)만 사용하므로
+//   terminate 핸들러, 시그널 핸들러에서 호출 가능
+// - 형식은 DetailedErrorMessage() 와 같음
+//   (std::throw_with_nested 로 중첩된 예외도 단계마다 기록, exception_ptr 을
+//    다시 던지지 않고 볼 수 없는 환경에서는 단계마다 rethrow 하므로 할당 발생)
+//   (아직 렌더링되지 않은 지연 포맷 메시지는 형식 문자열 그대로 기록)
+
+namespace contextual_exception {
+namespace anonymous {
+
+// fd 에 직접 기록하는 작성기 (스택 버퍼가 차면 write)
+// - 소멸 시 남은 내용을 기록하고 errno 를 원래 값으로 복원
+class FileDescriptorWriter {
+   public:
+    explicit FileDescriptorWriter(int fd)
+        : fd_(fd), size_(0), failed_(false), saved_errno_(errno) {}
+    FileDescriptorWriter(const FileDescriptorWriter&) = delete;
+    FileDescriptorWriter& operator=(const FileDescriptorWriter&) = delete;
+    ~FileDescriptorWriter() {
+        Flush();
+        errno = saved_errno_;
+    }
+
+    void Append(const char* text, std::size_t size) {
+        while (0 != size) {
+            if (sizeof(buffer_) == size_ && !Flush()) {
+                return;
+            }
+            std::size_t chunk = sizeof(buffer_) - size_;
+            if (chunk > size) {
+                chunk = size;
+            }
+            std::memcpy(buffer_ + size_, text, chunk);
+            size_ += chunk;
+            text += chunk;
+            size -= chunk;
+        }
+    }
+    void Append(const char* text) {
+        Append(text, std::strlen(text));
+    }
+    void AppendInteger(long long value) {
+        char digits[24];
+        BufferWriter writer(digits, sizeof(digits));
+        writer.AppendInteger(value);
+        Append(writer.Data(), writer.Size());
+    }
+
+    // 지금까지의 기록이 모두 성공했는지
+    bool Flush() {
+        const char* data = buffer_;
+        while (!failed_ && 0 != size_) {
+#if defined(_WIN32)
+            const int written =
+                _write(fd_, data, static_cast<unsigned int>(size_));
+#else
+            const ssize_t written = write(fd_, data, size_);
+#endif
+            if (written < 0) {
+                if (EINTR == errno) {
+                    continue;
+                }
+                failed_ = true;
+                break;
+            }
+            data += written;
+            size_ -= static_cast<std::size_t>(written);
+        }
+        size_ = 0;
+        return !failed_;
+    }
+
+   private:
+    int fd_;
+    char buffer_[256];
+    std::size_t size_;
+    bool failed_;
+    int saved_errno_;
+};
+
+// FrameSource 의 프레임을 차례로 기록하는 FrameSink
+template <typename Writer>
+class FrameTextSink : public FrameSink {
+   public:
+    explicit FrameTextSink(Writer* writer) : writer_(writer), first_(true) {}
+
+    virtual void AddFrame(const char* message, int code,
+                          const SourceSite& site) override {
+        BeginFrame();
+        WriteFrameText(writer_, site, code, message);
+    }
+    virtual void AddFrames(const ::ContextualException& exception) override {
+        BeginFrame();
+        const ::ContextualException::Frame& base_frame = exception.BaseFrame();
+        WriteFrameText(writer_, *base_frame.site, base_frame.code,
+                       base_frame.AvailableMessage());
+        for (const ::ContextualException::FrameNode* node =
+                 exception.ChildFrames();
+             node; node = node->next.get()) {
+            BeginFrame();
+            WriteFrameText(writer_, *node->frame.site, node->frame.code,
+                           node->frame.AvailableMessage());
+        }
+    }
+    virtual void AddOmittedFrames(std::size_t count) override {
+        writer_->Append("\n    ... ");
+        writer_->AppendInteger(static_cast<long long>(count));
+        writer_->Append(" frames omitted");
+    }
+
+   private:
+    void BeginFrame() {
+        if (!first_) {
+            writer_->Append("\n    ");
+        }
+        first_ = false;
+    }
+
+    Writer* writer_;
+    bool first_;
+};
+
+struct TerminateState {
+    std::atomic<int> fd;
+    std::atomic<std::terminate_handler> previous_handler;
+};
+inline TerminateState& GetTerminateState() {
+    static TerminateState state;
+    return state;
+}
+
+#if defined(CONTEXTUAL_EXCEPTION_FLIGHT_RECORDER)
+// 최근 기록을 오래된 순으로 한 줄씩 (경과 시간은 조회 시점 기준)
+inline void WriteFlightRecords(FileDescriptorWriter* writer) {
+    const std::chrono::steady_clock::time_point now =
+        std::chrono::steady_clock::now();
+    writer->Append("recent exceptions:\n");
+    FlightRecorder::Visit([writer, now](const FlightRecord& record) {
+        writer->Append("    ");
+        WriteFrameText(writer, *record.site, record.code, "");
+        writer->Append("(thread ");
+        writer->AppendInteger(static_cast<long long>(record.thread));
+        writer->Append(", ");
+        writer->AppendInteger(static_cast<long long>(
+            std::chrono::duration_cast<std::chrono::microseconds>(
+                now - record.time)
+                .count()));
+        writer->Append("us ago)\n");
+    });
+}
+#endif
+
+// 처리되지 않은 예외를 기록한 뒤 이전 핸들러 호출 (없으면 std::abort)
+// - throw; 로 현재 예외를 다시 던져 확인 (예외 객체 복사, 할당 없음)
+[[noreturn]] inline void TerminateHandler() {
+    TerminateState& state = GetTerminateState();
+    {
+        FileDescriptorWriter writer(state.fd.load(std::memory_order_relaxed));
+        if (std::current_exception()) {
+            writer.Append("terminate called after throwing: ");
+            try {
+                throw;
+            } catch (const FrameSource& exception) {
+                FrameTextSink<FileDescriptorWriter> sink(&writer);
+                VisitSourceFrames(exception, &sink);
+            } catch (const std::exception& exception) {
+                writer.Append(exception.what());
+            } catch (...) {
+                writer.Append("unknown exception");
+            }
+            writer.Append("\n");
+        } else {
+            writer.Append("terminate called without an active exception\n");
+        }
+#if defined(CONTEXTUAL_EXCEPTION_FLIGHT_RECORDER)
+        WriteFlightRecords(&writer);
+#endif
+    }
+
+    const std::terminate_handler previous_handler =
+        state.previous_handler.load(std::memory_order_relaxed);
+    if (previous_handler) {
+        previous_handler();
+    }
+    std::abort();
+}
+
+}  // namespace anonymous
+
+// exception 의 프레임 체인을 buffer 에 NUL 종료로 기록
+// - 잘리지 않았다면 필요한 길이를 반환 (snprintf 와 같은 규칙)
+inline std::size_t WriteFrames(const FrameSource& exception, char* buffer,
+                               std::size_t capacity) {
+    anonymous::BufferWriter writer(buffer, capacity);
+    anonymous::FrameTextSink<anonymous::BufferWriter> sink(&writer);
+    anonymous::VisitSourceFrames(exception, &sink);
+    return writer.RequiredSize();
+}
+
+// exception 의 프레임 체인과 개행을 fd 에 기록 (write 실패 시 false)
+inline bool WriteFrames(const FrameSource& exception, int fd) {
+    anonymous::FileDescriptorWriter writer(fd);
+    {
+        anonymous::FrameTextSink<anonymous::FileDescriptorWriter> sink(
+            &writer);
+        anonymous::VisitSourceFrames(exception, &sink);
+    }
+    writer.Append("\n");
+    return writer.Flush();
+}
+
+// std::terminate 시 처리되지 않은 예외의 프레임 체인을 fd 에 기록
+// - CONTEXTUAL_EXCEPTION_FLIGHT_RECORDER 정의 시 최근 예외 기록도 함께 기록
+// - 기록 후 이전 terminate 핸들러 호출 (없으면 std::abort)
+// - 다시 설치하면 fd 만 바뀜
+inline void InstallTerminateHandler(int fd = 2) {
+    anonymous::TerminateState& state = anonymous::GetTerminateState();
+    state.fd.store(fd, std::memory_order_relaxed);
+    const std::terminate_handler previous_handler =
+        std::set_terminate(&anonymous::TerminateHandler);
+    if (&anonymous::TerminateHandler != previous_handler) {
+        state.previous_handler.store(previous_handler,
+                                     std::memory_order_relaxed);
+    }
+}
+
+}  // namespace contextual_exception
+
+#endif  //__CONTEXTUAL_CRASH_REPORT_HPP__
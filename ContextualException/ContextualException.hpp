@@ -1,12 +1,35 @@
 #ifndef __CONTEXTUAL_EXCEPTION_HPP__
 #define __CONTEXTUAL_EXCEPTION_HPP__
 
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
 #include <cstring>
 #include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <ostream>
 #include <sstream>
 #include <string>
+#include <tuple>
+#include <type_traits>
+#include <typeinfo>
+#include <unordered_map>
 #include <vector>
 
+#if defined(__has_include)
+#if __has_include(<source_location>) && \
+    (__cplusplus >= 202002L || (defined(_MSVC_LANG) && _MSVC_LANG >= 202002L))
+#include <source_location>
+#endif
+#if __has_include(<string_view>) && \
+    (__cplusplus >= 201703L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201703L))
+#include <string_view>
+#endif
+#endif
+
 // __FILENAME__ : 소스 파일명 출력
 #ifndef __FILENAME__
 #if defined(_WIN32) || defined(WIN32) || defined(__CYGWIN__) || \
@@ -22,138 +45,1644 @@
 // MSVC C++11 탐지가 불완전하므로 리터럴 지원 여부로 판별
 #if defined(__cpp_user_defined_literals)
 #define CONTEXTUAL_EXCEPTION_NOEXCEPT noexcept
+#define CONTEXTUAL_EXCEPTION_NOEXCEPT_IF(condition) noexcept(condition)
 #else
 #define CONTEXTUAL_EXCEPTION_NOEXCEPT
+#define CONTEXTUAL_EXCEPTION_NOEXCEPT_IF(condition)
+#endif
+
+// 매크로의 throw 경로를 호출 지점 밖(cold 영역)으로 분리
+#if defined(__GNUC__)
+#define CONTEXTUAL_EXCEPTION_COLD __attribute__((cold, noinline))
+#elif defined(_MSC_VER)
+#define CONTEXTUAL_EXCEPTION_COLD __declspec(noinline)
+#else
+#define CONTEXTUAL_EXCEPTION_COLD
+#endif
+
+// 분기 예측 힌트
+#if defined(__GNUC__)
+#define CONTEXTUAL_LIKELY(condition) __builtin_expect(!!(condition), 1)
+#define CONTEXTUAL_UNLIKELY(condition) __builtin_expect(!!(condition), 0)
+#else
+#define CONTEXTUAL_LIKELY(condition) (!!(condition))
+#define CONTEXTUAL_UNLIKELY(condition) (!!(condition))
+#endif
+
+// what() 렌더링 시점
+// - 기본: what()/DetailedErrorMessage() 최초 호출 시 1회 렌더링 (thread-safe)
+// - CONTEXTUAL_EXCEPTION_EAGER_WHAT 정의 시: 생성 시점에 즉시 렌더링
+
+namespace contextual_exception {
+
+class SiteCounter;
+
+// 호출 위치 정보
+// - 매크로 호출 지점마다 정적 상수로 1개 생성되고 프레임은 포인터만 보관
+// - file 은 컴파일 시점에 계산된 파일명(경로 제외)
+// - counter 는 지점별 집계 레코드 (CONTEXTUAL_EXCEPTION_SITE_COUNTERS 미정의 시
+//   nullptr)
+struct SourceSite {
+    const char* file;
+    const char* function;
+    int line;
+    SiteCounter* counter;
+};
+
+// 호출 지점에서 생성된 예외 수와 코드별 수 (CONTEXTUAL_EXCEPTION_SITE_COUNTERS)
+// - 매크로 호출 지점마다 정적 객체로 1개 (0 초기화, 생성자 실행 없음)
+// - 최초 기록 시 CAS 로 전역 목록에 1회 등록 (락, 할당 없음)
+// - 기록당 relaxed 원자적 증가 1회 (예외 생성 비용에 비해 무시할 수준)
+// - 코드는 먼저 나온 kCodeSlots 개까지 따로 세고 나머지는 합산
+// - 컨텍스트 추가(AddContext 등)는 새 예외가 아니므로 세지 않음
+class SiteCounter {
+   public:
+    enum { kCodeSlots = 4 };
+
+    void Record(const SourceSite& site,
+                int code) CONTEXTUAL_EXCEPTION_NOEXCEPT {
+        if (CONTEXTUAL_UNLIKELY(nullptr ==
+                                site_.load(std::memory_order_acquire))) {
+            Register(site);
+        }
+
+        // 총 횟수는 코드별 횟수의 합 (기록당 원자적 증가 1회)
+        const std::uint64_t key = CodeKey(code);
+        for (std::size_t ii = 0; ii < kCodeSlots; ++ii) {
+            std::uint64_t slot_key =
+                code_keys_[ii].load(std::memory_order_relaxed);
+            if (0 == slot_key &&
+                code_keys_[ii].compare_exchange_strong(
+                    slot_key, key, std::memory_order_relaxed)) {
+                slot_key = key;
+            }
+            if (key == slot_key) {
+                code_counts_[ii].fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+        }
+        other_codes_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // 등록된 첫 카운터 (이후 Next() 로 순회, 등록 역순)
+    static const SiteCounter* First() CONTEXTUAL_EXCEPTION_NOEXCEPT {
+        return Head().load(std::memory_order_acquire);
+    }
+    const SiteCounter* Next() const CONTEXTUAL_EXCEPTION_NOEXCEPT {
+        return next_.load(std::memory_order_relaxed);
+    }
+
+    // 등록된 카운터는 항상 유효
+    const SourceSite* Site() const CONTEXTUAL_EXCEPTION_NOEXCEPT {
+        return site_.load(std::memory_order_acquire);
+    }
+    std::uint64_t Count() const CONTEXTUAL_EXCEPTION_NOEXCEPT {
+        std::uint64_t count = other_codes_.load(std::memory_order_relaxed);
+        for (std::size_t ii = 0; ii < kCodeSlots; ++ii) {
+            count += code_counts_[ii].load(std::memory_order_relaxed);
+        }
+        return count;
+    }
+    // index 번째 코드 슬롯 (비어 있으면 false)
+    bool CodeCount(std::size_t index, int* code, std::uint64_t* count) const
+        CONTEXTUAL_EXCEPTION_NOEXCEPT {
+        const std::uint64_t key =
+            code_keys_[index].load(std::memory_order_relaxed);
+        if (0 == key) {
+            return false;
+        }
+        *code = static_cast<int>(static_cast<std::uint32_t>(key));
+        *count = code_counts_[index].load(std::memory_order_relaxed);
+        return true;
+    }
+    // 코드 슬롯에 들지 못한 코드의 수 합계
+    std::uint64_t OtherCodeCount() const CONTEXTUAL_EXCEPTION_NOEXCEPT {
+        return other_codes_.load(std::memory_order_relaxed);
+    }
+
+   private:
+    // 빈 슬롯(0)과 구분되도록 32번 비트를 세움
+    static std::uint64_t CodeKey(int code) CONTEXTUAL_EXCEPTION_NOEXCEPT {
+        return (static_cast<std::uint64_t>(1) << 32) |
+               static_cast<std::uint32_t>(code);
+    }
+
+    static std::atomic<SiteCounter*>& Head() CONTEXTUAL_EXCEPTION_NOEXCEPT {
+        static std::atomic<SiteCounter*> head;
+        return head;
+    }
+
+    CONTEXTUAL_EXCEPTION_COLD void Register(const SourceSite& site)
+        CONTEXTUAL_EXCEPTION_NOEXCEPT {
+        const SourceSite* expected = nullptr;
+        if (!site_.compare_exchange_strong(expected, &site,
+                                           std::memory_order_acq_rel)) {
+            return;
+        }
+        SiteCounter* head = Head().load(std::memory_order_relaxed);
+        do {
+            next_.store(head, std::memory_order_relaxed);
+        } while (!Head().compare_exchange_weak(head, this,
+                                               std::memory_order_release,
+                                               std::memory_order_relaxed));
+    }
+
+    std::atomic<const SourceSite*> site_;
+    std::atomic<SiteCounter*> next_;
+    std::atomic<std::uint64_t> code_keys_[kCodeSlots];
+    std::atomic<std::uint64_t> code_counts_[kCodeSlots];
+    std::atomic<std::uint64_t> other_codes_;
+};
+
+namespace anonymous {
+
+#if defined(CONTEXTUAL_EXCEPTION_FLIGHT_RECORDER)
+// ContextualFlightRecorder.hpp
+inline void RecordFlight(const SourceSite& site,
+                         int code) CONTEXTUAL_EXCEPTION_NOEXCEPT;
+#endif
+
+// 예외 생성 1회 기록
+// - 카운터가 연결된 호출 지점이면 지점별 횟수
+// - CONTEXTUAL_EXCEPTION_FLIGHT_RECORDER 정의 시 스레드별 최근 기록
+inline void RecordSite(const SourceSite& site, int code)
+    CONTEXTUAL_EXCEPTION_NOEXCEPT {
+    if (site.counter) {
+        site.counter->Record(site, code);
+    }
+#if defined(CONTEXTUAL_EXCEPTION_FLIGHT_RECORDER)
+    RecordFlight(site, code);
+#endif
+}
+
+#if defined(_WIN32) || defined(WIN32) || defined(__CYGWIN__) || \
+    defined(__MINGW32__) || defined(__BORLANDC__)
+constexpr bool IsPathSeparator(char character) {
+    return '\\' == character;
+}
+#else
+constexpr bool IsPathSeparator(char character) {
+    return '/' == character;
+}
+#endif
+
+// [begin, end) 구간의 마지막 경로 구분자 다음 위치 (없으면 0)
+// C++11 constexpr 재귀 깊이 제한을 피하기 위해 반씩 나누어 탐색
+constexpr std::size_t BasenameOffset(const char* path, std::size_t begin,
+                                     std::size_t end) {
+    return end - begin <= 1
+               ? (end > begin && IsPathSeparator(path[begin]) ? begin + 1 : 0)
+           : 0 != BasenameOffset(path, begin + (end - begin) / 2, end)
+               ? BasenameOffset(path, begin + (end - begin) / 2, end)
+               : BasenameOffset(path, begin, begin + (end - begin) / 2);
+}
+
+// 최초 조회 시 1회 렌더링되어 게시되는 문자열
+// - 여러 스레드가 동시에 조회해도 CAS 에 성공한 결과 하나만 게시
+// - 렌더링 실패(메모리 부족) 시 nullptr 반환, 예외를 던지지 않음
+class LazyString {
+   public:
+    LazyString() : rendered_(nullptr) {}
+    LazyString(const LazyString&) = delete;
+    LazyString& operator=(const LazyString&) = delete;
+    ~LazyString() {
+        delete rendered_.load(std::memory_order_acquire);
+    }
+
+    template <typename Render>
+    const std::string* Get(const Render& render) const
+        CONTEXTUAL_EXCEPTION_NOEXCEPT {
+        const std::string* rendered =
+            rendered_.load(std::memory_order_acquire);
+        if (rendered) {
+            return rendered;
+        }
+
+        std::string* candidate = nullptr;
+        try {
+            std::unique_ptr<std::string> output(new std::string());
+            render(output.get());
+            candidate = output.release();
+        } catch (...) {
+            return nullptr;
+        }
+
+        std::string* expected = nullptr;
+        if (!rendered_.compare_exchange_strong(expected, candidate,
+                                               std::memory_order_acq_rel,
+                                               std::memory_order_acquire)) {
+            delete candidate;
+            return expected;
+        }
+        return candidate;
+    }
+
+    // 이미 게시된 결과 (없으면 nullptr, 렌더링하지 않음)
+    const std::string* Peek() const CONTEXTUAL_EXCEPTION_NOEXCEPT {
+        return rendered_.load(std::memory_order_acquire);
+    }
+
+   private:
+    mutable std::atomic<std::string*> rendered_;
+};
+
+// 참조 카운트를 노드 안에 두는 공유 포인터 (포인터 1개 크기)
+// - 복사는 원자적 증가 1회, 제어 블록 할당 없음
+// - Node 는 1 로 초기화된 mutable std::atomic<long> reference_count 를 가짐
+template <typename Node>
+class IntrusivePointer {
+   public:
+    IntrusivePointer() : node_(nullptr) {}
+    IntrusivePointer(std::nullptr_t) : node_(nullptr) {}
+    // 새로 만든 노드의 소유권을 넘겨받음 (reference_count 증가 없음)
+    explicit IntrusivePointer(Node* node) : node_(node) {}
+    IntrusivePointer(const IntrusivePointer& other) : node_(other.node_) {
+        if (node_) {
+            node_->reference_count.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+    IntrusivePointer(IntrusivePointer&& other) CONTEXTUAL_EXCEPTION_NOEXCEPT
+        : node_(other.node_) {
+        other.node_ = nullptr;
+    }
+    IntrusivePointer& operator=(const IntrusivePointer& other) {
+        IntrusivePointer(other).Swap(*this);
+        return *this;
+    }
+    IntrusivePointer& operator=(IntrusivePointer&& other)
+        CONTEXTUAL_EXCEPTION_NOEXCEPT {
+        IntrusivePointer(std::move(other)).Swap(*this);
+        return *this;
+    }
+    ~IntrusivePointer() {
+        if (node_ && Unreference(node_)) {
+            delete node_;
+        }
+    }
+
+    Node* get() const {
+        return node_;
+    }
+    Node& operator*() const {
+        return *node_;
+    }
+    Node* operator->() const {
+        return node_;
+    }
+    explicit operator bool() const {
+        return nullptr != node_;
+    }
+    long use_count() const {
+        return node_ ? node_->reference_count.load(std::memory_order_acquire)
+                     : 0;
+    }
+
+    // 참조를 유지한 채 소유권을 호출자에게 넘김 (Unreference 로 해제)
+    Node* release() {
+        Node* node = node_;
+        node_ = nullptr;
+        return node;
+    }
+    // 참조 1개 해제, 마지막 참조였으면 true (호출자가 delete)
+    static bool Unreference(Node* node) {
+        return 1 == node->reference_count.fetch_sub(1,
+                                                     std::memory_order_acq_rel);
+    }
+
+   private:
+    void Swap(IntrusivePointer& other) {
+        Node* node = node_;
+        node_ = other.node_;
+        other.node_ = node;
+    }
+
+   private:
+    Node* node_;
+};
+
+// 형식 문자열의 {} 개수 (짝이 맞지 않는 중괄호가 있으면 -1)
+// - {{, }} 는 중괄호 문자 자체
+#if defined(__cpp_constexpr) && __cpp_constexpr >= 201304L
+constexpr int CountFormatPlaceholders(const char* format) {
+    int count = 0;
+    while ('\0' != *format) {
+        if ('{' == format[0] && '{' == format[1]) {
+            format += 2;
+        } else if ('{' == format[0] && '}' == format[1]) {
+            format += 2;
+            ++count;
+        } else if ('}' == format[0] && '}' == format[1]) {
+            format += 2;
+        } else if ('{' == format[0] || '}' == format[0]) {
+            return -1;
+        } else {
+            ++format;
+        }
+    }
+    return count;
+}
+#else
+// C++11: 재귀 깊이가 형식 문자열 길이만큼 필요 (GCC 기본 한도 512)
+constexpr int CountFormatPlaceholders(const char* format, int count = 0) {
+    return '\0' == format[0] ? count
+           : ('{' == format[0] && '{' == format[1]) ||
+                   ('}' == format[0] && '}' == format[1])
+               ? CountFormatPlaceholders(format + 2, count)
+           : '{' == format[0] && '}' == format[1]
+               ? CountFormatPlaceholders(format + 2, count + 1)
+           : '{' == format[0] || '}' == format[0]
+               ? -1
+               : CountFormatPlaceholders(format + 1, count);
+}
 #endif
 
-class ContextualException : public std::exception {
+// 형식 문자열의 {} 개수(Placeholders)와 인자 개수(Arguments) 검사
+template <int Placeholders, std::size_t Arguments>
+struct FormatArgumentsCheck {
+    static_assert(Placeholders >= 0,
+                  "format string has an unmatched '{' or '}'");
+    static_assert(Placeholders == static_cast<int>(Arguments),
+                  "number of {} in format string and arguments differ");
+    static const bool value = true;
+};
+
+// 다음 {} 직전까지의 문자열을 출력하고 {} 다음 위치를 반환 (끝이면 nullptr)
+inline const char* WriteFormatText(std::ostream& stream, const char* format) {
+    while ('\0' != *format) {
+        if ('{' == format[0] && '}' == format[1]) {
+            return format + 2;
+        }
+        if (('{' == format[0] && '{' == format[1]) ||
+            ('}' == format[0] && '}' == format[1])) {
+            ++format;
+        }
+        stream.put(*format);
+        ++format;
+    }
+    return nullptr;
+}
+
+// 소유하지 않는 문자열 참조 (const char*, std::string 에서 암시적 변환)
+struct TextView {
+    const char* data;
+    std::size_t size;
+
+    TextView(const char* text)
+        : data(text ? text : ""), size(text ? std::strlen(text) : 0) {}
+    TextView(const std::string& text) : data(text.data()), size(text.size()) {}
+    TextView(const char* data, std::size_t size) : data(data), size(size) {}
+};
+
+// 고정 버퍼 문자열 작성기
+// - 동적 할당 없음, 항상 NUL 종료
+// - 용량을 넘으면 UTF-8 문자 경계에서 잘라내고 이후 추가는 무시
+class BufferWriter {
    public:
+    BufferWriter(char* buffer, std::size_t capacity)
+        : buffer_(buffer), capacity_(capacity), size_(0), required_size_(0) {
+        if (0 != capacity_) {
+            buffer_[0] = '\0';
+        }
+    }
+
+    void Append(const char* text, std::size_t size) {
+        const bool truncated = Truncated();
+        required_size_ += size;
+        if (truncated || 0 == capacity_) {
+            return;
+        }
+
+        std::size_t writable = capacity_ - 1 - size_;
+        if (size > writable) {
+            while (0 != writable && IsUtf8Continuation(text[writable])) {
+                --writable;
+            }
+            size = writable;
+        }
+        std::memcpy(buffer_ + size_, text, size);
+        size_ += size;
+        buffer_[size_] = '\0';
+    }
+    void Append(const char* text) {
+        Append(text, std::strlen(text));
+    }
+    void AppendInteger(long long value) {
+        char digits[24];
+        char* end = digits + sizeof(digits);
+        char* begin = end;
+        unsigned long long magnitude =
+            value < 0 ? 0ULL - static_cast<unsigned long long>(value)
+                      : static_cast<unsigned long long>(value);
+        do {
+            *--begin = static_cast<char>('0' + magnitude % 10);
+            magnitude /= 10;
+        } while (0 != magnitude);
+        if (value < 0) {
+            *--begin = '-';
+        }
+        Append(begin, static_cast<std::size_t>(end - begin));
+    }
+
+    const char* Data() const {
+        return buffer_;
+    }
+    // 기록된 길이 (NUL 제외)
+    std::size_t Size() const {
+        return size_;
+    }
+    // 잘리지 않았다면 필요했을 길이 (NUL 제외)
+    std::size_t RequiredSize() const {
+        return required_size_;
+    }
+    bool Truncated() const {
+        return required_size_ != size_;
+    }
+
+   private:
+    static bool IsUtf8Continuation(char character) {
+        return 0x80 == (static_cast<unsigned char>(character) & 0xC0);
+    }
+
+   private:
+    char* buffer_;
+    std::size_t capacity_;
+    std::size_t size_;
+    std::size_t required_size_;
+};
+
+// 조각마다 append(const char* data, std::size_t size) 를 호출하는 작성기
+// (std::ostream, std::string, 로거 버퍼 등에 중간 문자열 없이 기록)
+template <typename Function>
+class AppendWriter {
+   public:
+    explicit AppendWriter(const Function& append) : append_(append) {}
+
+    void Append(const char* text, std::size_t size) {
+        append_(text, size);
+    }
+    void Append(const char* text) {
+        append_(text, std::strlen(text));
+    }
+    void AppendInteger(long long value) {
+        char digits[24];
+        BufferWriter writer(digits, sizeof(digits));
+        writer.AppendInteger(value);
+        append_(writer.Data(), writer.Size());
+    }
+
+   private:
+    const Function& append_;
+};
+
+// 프레임 1개를 "file:line | function() | [code=N] message" 형식으로 기록
+// (Writer: BufferWriter 와 같은 Append/AppendInteger 를 가진 작성기)
+template <typename Writer>
+inline void WriteFrameText(Writer* writer, const SourceSite& site, int code,
+                           TextView message) {
+    writer->Append(site.file);
+    writer->Append(":");
+    writer->AppendInteger(site.line);
+    writer->Append(" | ");
+    writer->Append(site.function);
+    writer->Append("() | ");
+    if (0 != code) {
+        writer->Append("[code=");
+        writer->AppendInteger(code);
+        writer->Append("] ");
+    }
+    writer->Append(message.data, message.size);
+}
+
+// 지연 포맷 인자의 보관 타입
+// - 문자열(C 문자열, string_view)은 호출자 버퍼 수명과 무관하도록
+//   std::string 으로 복사
+// - 그 외 포인터, reference_wrapper 는 렌더링 시점에 가리키는 대상이
+//   사라졌을 수 있으므로 거부 (값으로 넘기거나 미리 포맷할 것)
+template <typename Value>
+struct FormatStorage {
+    typedef typename std::decay<Value>::type type;
+    static_assert(!std::is_pointer<type>::value,
+                  "deferred format arguments must not borrow storage: "
+                  "pass the pointee by value or format eagerly");
+};
+template <typename Value>
+struct FormatStorage<std::reference_wrapper<Value>> {
+    static_assert(sizeof(Value) == 0,
+                  "deferred format arguments must not borrow storage: "
+                  "pass the referenced value by value");
+};
+#if defined(__cpp_lib_string_view)
+template <typename Char, typename Traits>
+struct FormatStorage<std::basic_string_view<Char, Traits>> {
+    typedef std::basic_string<Char, Traits> type;
+};
+#endif
+template <>
+struct FormatStorage<const char*> {
+    typedef std::string type;
+};
+template <>
+struct FormatStorage<char*> {
+    typedef std::string type;
+};
+template <typename Value>
+struct FormatStorage<Value&> : FormatStorage<Value> {};
+template <typename Value>
+struct FormatStorage<Value&&> : FormatStorage<Value> {};
+template <typename Value>
+struct FormatStorage<const Value> : FormatStorage<Value> {};
+template <std::size_t Size>
+struct FormatStorage<char[Size]> {
+    typedef std::string type;
+};
+template <std::size_t Size>
+struct FormatStorage<const char[Size]> {
+    typedef std::string type;
+};
+
+}  // namespace anonymous
+
+// 지연 포맷 메시지
+// - 형식 문자열(리터럴)과 인자만 보관하고 최초 조회 시 렌더링
+// - 렌더링 결과는 여러 스레드가 공유
+class FormattedMessage {
+   public:
+    explicit FormattedMessage(const char* format) : format_(format) {}
+    FormattedMessage(const FormattedMessage&) = delete;
+    FormattedMessage& operator=(const FormattedMessage&) = delete;
+    virtual ~FormattedMessage() {}
+
+    const char* Format() const {
+        return format_;
+    }
+    // 렌더링 실패(메모리 부족) 시 nullptr
+    const std::string* Rendered() const CONTEXTUAL_EXCEPTION_NOEXCEPT {
+        return rendered_.Get(
+            [this](std::string* output) { this->Render(output); });
+    }
+    // 이미 렌더링된 결과 (없으면 nullptr, 렌더링하지 않음)
+    const std::string* Peek() const CONTEXTUAL_EXCEPTION_NOEXCEPT {
+        return rendered_.Peek();
+    }
+
+   protected:
+    virtual void Render(std::string* output) const = 0;
+
+   private:
+    const char* format_;
+    anonymous::LazyString rendered_;
+};
+
+template <typename... Arguments>
+class BasicFormattedMessage : public FormattedMessage {
+   public:
+    template <typename... Values>
+    explicit BasicFormattedMessage(const char* format, Values&&... values)
+        : FormattedMessage(format),
+          arguments_(std::forward<Values>(values)...) {}
+
+   protected:
+    virtual void Render(std::string* output) const override {
+        std::ostringstream stream;
+        RenderFrom(stream, Format(), std::integral_constant<std::size_t, 0>());
+        *output = stream.str();
+    }
+
+   private:
+    template <std::size_t Index>
+    void RenderFrom(std::ostream& stream, const char* format,
+                    std::integral_constant<std::size_t, Index>) const {
+        const char* rest = anonymous::WriteFormatText(stream, format);
+        if (!rest) {
+            return;
+        }
+        stream << std::get<Index>(arguments_);
+        RenderFrom(stream, rest,
+                   std::integral_constant<std::size_t, Index + 1>());
+    }
+    void RenderFrom(
+        std::ostream& stream, const char* format,
+        std::integral_constant<std::size_t, sizeof...(Arguments)>) const {
+        anonymous::WriteFormatText(stream, format);
+    }
+
+   private:
+    std::tuple<Arguments...> arguments_;
+};
+
+// 범위 컨텍스트 (CONTEXTUAL_SCOPE)
+// - 스레드별 스택에 호출 지점과 인자만 기록 (진입/해제는 포인터 저장 2회,
+//   할당, 포맷 없음)
+// - 범위 안에서 만들어진 ContextualException 이 다른 예외의 프레임을 넘겨받지
+//   않았으면 활성 범위를 안쪽부터 하위 프레임으로 붙임 (이때만 인자 복사)
+//   하위 ContextualException 을 감싸는 예외는 하위 예외가 이미 가졌다고 봄
+// - 범위는 만들어진 스레드에서 역순으로 해제되어야 함 (코루틴에서 co_await 를
+//   사이에 둔 범위 금지, 디버그 빌드에서 assert 로 검사)
+class ScopeContext {
+   public:
+    ScopeContext(const ScopeContext&) = delete;
+    ScopeContext& operator=(const ScopeContext&) = delete;
+
+    // 현재 스레드의 가장 안쪽 범위 (없으면 nullptr)
+    static const ScopeContext* Current() CONTEXTUAL_EXCEPTION_NOEXCEPT {
+        return Top();
+    }
+    // 바깥 범위 (없으면 nullptr)
+    const ScopeContext* Previous() const CONTEXTUAL_EXCEPTION_NOEXCEPT {
+        return previous_;
+    }
+    const SourceSite& Site() const CONTEXTUAL_EXCEPTION_NOEXCEPT {
+        return site_;
+    }
+    // 인자를 복사한 지연 포맷 메시지 (범위가 끝나도 유효)
+    std::shared_ptr<const FormattedMessage> MakeMessage() const {
+        return make_message_(this);
+    }
+
+   protected:
+    typedef std::shared_ptr<const FormattedMessage> (*MakeMessageFunction)(
+        const ScopeContext* scope);
+
+    ScopeContext(const SourceSite& site, MakeMessageFunction make_message)
+        : site_(site), make_message_(make_message), previous_(Top()) {
+        Top() = this;
+    }
+    ~ScopeContext() {
+        assert(Top() == this &&
+               "CONTEXTUAL_SCOPE released out of order (spans co_await?)");
+        Top() = previous_;
+    }
+
+   private:
+    static const ScopeContext*& Top() CONTEXTUAL_EXCEPTION_NOEXCEPT {
+        static thread_local const ScopeContext* top = nullptr;
+        return top;
+    }
+
+    const SourceSite& site_;
+    const MakeMessageFunction make_message_;
+    const ScopeContext* const previous_;
+};
+
+namespace anonymous {
+
+template <std::size_t... Indices>
+struct IndexList {};
+template <std::size_t Count, std::size_t... Indices>
+struct MakeIndexList : MakeIndexList<Count - 1, Count - 1, Indices...> {};
+template <std::size_t... Indices>
+struct MakeIndexList<0, Indices...> {
+    typedef IndexList<Indices...> type;
+};
+
+// Values: lvalue 인자는 참조, rvalue 인자는 값으로 보관
+template <typename... Values>
+class BasicScopeContext : public ScopeContext {
+   public:
+    template <typename... Arguments>
+    BasicScopeContext(const SourceSite& site, const char* format,
+                      Arguments&&... arguments)
+        : ScopeContext(site, &BasicScopeContext::Make),
+          format_(format),
+          values_(std::forward<Arguments>(arguments)...) {}
+
+   private:
+    static std::shared_ptr<const FormattedMessage> Make(
+        const ScopeContext* scope) {
+        return static_cast<const BasicScopeContext*>(scope)->Make(
+            typename MakeIndexList<sizeof...(Values)>::type());
+    }
+    template <std::size_t... Indices>
+    std::shared_ptr<const FormattedMessage> Make(
+        IndexList<Indices...>) const {
+        return std::make_shared<const BasicFormattedMessage<
+            typename FormatStorage<Values>::type...>>(
+            format_, std::get<Indices>(values_)...);
+    }
+
+    const char* format_;
+    std::tuple<Values...> values_;
+};
+
+// 반환값을 auto&& 로 받아 복사, 이동 없이 범위 끝까지 유지
+template <int Placeholders, typename... Values>
+inline BasicScopeContext<Values...> MakeScope(const SourceSite& site,
+                                              const char* format,
+                                              Values&&... values) {
+    static_assert(FormatArgumentsCheck<Placeholders, sizeof...(Values)>::value,
+                  "invalid format arguments");
+    return {site, format, std::forward<Values>(values)...};
+}
+
+}  // namespace anonymous
+
+// 런타임 문자열로부터 SourceSite 획득 (등록된 레코드가 max_sites 개 이상이면
+// 새 위치는 등록하지 않고 nullptr)
+// - 동일한 (file, line, function) 은 항상 같은 레코드를 반환
+// - 레코드는 프로세스 종료까지 유지
+// - 외부 입력처럼 위치 수가 정해지지 않은 경우 한도를 지정
+inline const SourceSite* TryInternSourceSite(const std::string& file, int line,
+                                             const std::string& function,
+                                             std::size_t max_sites) {
+    struct InternedSite {
+        std::string file;
+        std::string function;
+        SourceSite site;
+        SiteCounter counter;
+    };
+    static std::mutex mutex;
+    static auto* sites =
+        new std::unordered_map<std::string, std::unique_ptr<InternedSite>>();
+
+    std::string key = file;
+    key += '\0';
+    key += function;
+    key += '\0';
+    key += std::to_string(line);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    const auto found = sites->find(key);
+    if (sites->end() != found) {
+        return &found->second->site;
+    }
+    if (sites->size() >= max_sites) {
+        return nullptr;
+    }
+    std::unique_ptr<InternedSite> interned(new InternedSite());
+    interned->file = file;
+    interned->function = function;
+    interned->site.file = interned->file.c_str();
+    interned->site.function = interned->function.c_str();
+    interned->site.line = line;
+#if defined(CONTEXTUAL_EXCEPTION_SITE_COUNTERS)
+    interned->site.counter = &interned->counter;
+#endif
+    const SourceSite* site = &interned->site;
+    sites->emplace(std::move(key), std::move(interned));
+    return site;
+}
+
+// 런타임 문자열로부터 SourceSite 획득 (한도 없음, 호출 지점 수만큼만 증가)
+inline const SourceSite& InternSourceSite(const std::string& file, int line,
+                                          const std::string& function) {
+    return *TryInternSourceSite(file, line, function,
+                                static_cast<std::size_t>(-1));
+}
+
+#if defined(__cpp_lib_source_location)
+namespace anonymous {
+
+// source_location::function_name() 의 전체 시그니처에서 __FUNCTION__ 과 같은
+// 이름만 추출 ("Task<int> ns::Top(int) [with T = int]" -> "Top")
+inline std::string FunctionBaseName(const char* signature) {
+    std::string name(signature);
+    const std::size_t with = name.find(" [with ");
+    if (std::string::npos != with) {
+        name.resize(with);
+    }
+    if (std::string::npos != name.find("<lambda")) {
+        return "operator()";
+    }
+
+    // 매개변수 목록 (마지막 ')' 와 짝인 '(') 이후 제거
+    const std::size_t close = name.rfind(')');
+    if (std::string::npos == close) {
+        return name;
+    }
+    int depth = 0;
+    for (std::size_t ii = close + 1; ii-- > 0;) {
+        if (')' == name[ii]) {
+            ++depth;
+        } else if ('(' == name[ii] && 0 == --depth) {
+            name.resize(ii);
+            break;
+        }
+    }
+
+    // 연산자 함수는 "operator" 부터
+    const std::size_t keyword = name.rfind("operator");
+    if (std::string::npos != keyword &&
+        (0 == keyword || ' ' == name[keyword - 1] ||
+         ':' == name[keyword - 1]) &&
+        std::string::npos == name.find("::", keyword)) {
+        return name.substr(keyword);
+    }
+
+    // 함수 템플릿 인자 제거 ("Parse<int>" -> "Parse")
+    if (!name.empty() && '>' == name.back()) {
+        depth = 0;
+        for (std::size_t ii = name.size(); ii-- > 0;) {
+            if ('>' == name[ii]) {
+                ++depth;
+            } else if ('<' == name[ii] && 0 == --depth) {
+                name.resize(ii);
+                break;
+            }
+        }
+    }
+
+    // 마지막 ' ', "::" 등 이후 (템플릿 인자 안은 제외)
+    depth = 0;
+    for (std::size_t ii = name.size(); ii-- > 0;) {
+        const char character = name[ii];
+        if ('>' == character) {
+            ++depth;
+        } else if ('<' == character) {
+            depth -= depth > 0 ? 1 : 0;
+        } else if (0 == depth && (' ' == character || ':' == character ||
+                                  '*' == character || '&' == character)) {
+            return name.substr(ii + 1);
+        }
+    }
+    return name;
+}
+
+}  // namespace anonymous
+
+// 이름은 __FUNCTION__ 과 같은 형태로 등록
+inline const SourceSite& InternSourceSite(
+    const std::source_location& location) {
+    const char* file = location.file_name();
+    return InternSourceSite(
+        file + anonymous::BasenameOffset(file, 0, std::strlen(file)),
+        static_cast<int>(location.line()),
+        anonymous::FunctionBaseName(location.function_name()));
+}
+#endif
+
+}  // namespace contextual_exception
+
+// 컴파일 시점 파일명: __FILE__ 에서 마지막 경로 구분자 이후
+#define __CONTEXTUAL_FILE_BASENAME                                     \
+    (__FILE__ + std::integral_constant<                                \
+                    std::size_t,                                       \
+                    ::contextual_exception::anonymous::BasenameOffset( \
+                        __FILE__, 0, sizeof(__FILE__) - 1)>::value)
+
+// 호출 지점별 카운터 (CONTEXTUAL_EXCEPTION_SITE_COUNTERS 정의 시)
+// - 모든 번역 단위에서 같게 정의할 것
+// - 조회는 ContextualSiteCounters.hpp 참고
+#if defined(CONTEXTUAL_EXCEPTION_SITE_COUNTERS)
+#define __CONTEXTUAL_SITE_COUNTER_DECLARATION \
+    static ::contextual_exception::SiteCounter __contextual_site_counter;
+#define __CONTEXTUAL_SITE_COUNTER (&__contextual_site_counter)
+#else
+#define __CONTEXTUAL_SITE_COUNTER_DECLARATION
+#define __CONTEXTUAL_SITE_COUNTER nullptr
+#endif
+
+// 호출 지점의 정적 SourceSite 레코드 주소 (const SourceSite*)
+// - 최초 1회 초기화되는 람다 안의 정적 레코드 (호출마다 초기화 여부 검사)
+// - 함수 밖(네임스페이스 범위, 기본 멤버 초기화, 기본 인자)에서도 사용 가능
+//   (예외 생성 매크로는 함수 본문 전용이므로 함수 밖에서는 생성자에 전달)
+//   const ContextualException kClosed("closed", *CONTEXTUAL_SOURCE_SITE());
+// - GCC/Clang: 람다는 cold/noinline (초기화 코드가 호출 지점 밖에 위치)
+//   (람다 내부에서는 __FUNCTION__ 이 람다를 가리키므로 인자로 전달)
+#define CONTEXTUAL_SOURCE_SITE() __CONTEXTUAL_SOURCE_SITE_OF(__FUNCTION__)
+#if defined(__GNUC__)
+#define __CONTEXTUAL_SITE_LAMBDA_ATTRIBUTES __attribute__((cold, noinline))
+#else
+#define __CONTEXTUAL_SITE_LAMBDA_ATTRIBUTES
+#endif
+#define __CONTEXTUAL_SOURCE_SITE_OF(function_name)                       \
+    ([](const char* function) __CONTEXTUAL_SITE_LAMBDA_ATTRIBUTES        \
+         -> const ::contextual_exception::SourceSite* {                  \
+             __CONTEXTUAL_SITE_COUNTER_DECLARATION                       \
+             static const ::contextual_exception::SourceSite             \
+                 __contextual_source_site = {__CONTEXTUAL_FILE_BASENAME, \
+                                             function, __LINE__,         \
+                                             __CONTEXTUAL_SITE_COUNTER}; \
+             return &__contextual_source_site;                           \
+         }(function_name))
+
+// 예외 생성 매크로(CONTEXTUAL_EXCEPTION, WRAP_*, THROW_*, CHECK 등)용
+// CONTEXTUAL_SOURCE_SITE (함수 본문 안에서만 사용)
+// - GCC/Clang: 구문 표현식 안의 static constexpr 레코드 (초기화 검사나 람다
+//   없이 주소 상수만 남음)
+#if defined(__GNUC__)
+#define __CONTEXTUAL_FUNCTION_SOURCE_SITE()                         \
+    __extension__({                                                 \
+        __CONTEXTUAL_SITE_COUNTER_DECLARATION                       \
+        static constexpr ::contextual_exception::SourceSite         \
+            __contextual_source_site = {__CONTEXTUAL_FILE_BASENAME, \
+                                        __FUNCTION__, __LINE__,     \
+                                        __CONTEXTUAL_SITE_COUNTER}; \
+        &__contextual_source_site;                                  \
+    })
+#else
+#define __CONTEXTUAL_FUNCTION_SOURCE_SITE() CONTEXTUAL_SOURCE_SITE()
+#endif
+
+class ContextualException;
+
+namespace contextual_exception {
+
+// FrameSource 가 자신의 프레임을 전달하는 대상 (감싸는 예외가 구현)
+class FrameSink {
+   public:
+    // 기본 프레임부터 순서대로 호출
+    virtual void AddFrame(const char* message, int code,
+                          const SourceSite& site) = 0;
+    // ContextualException 체인 전체 (공유 가능하면 복사 없이 O(1))
+    // (std::nested_exception 단계를 순회하면 뒤에 프레임이 더 올 수 있음)
+    virtual void AddFrames(const ::ContextualException& exception) = 0;
+    // 용량 초과로 생략된 프레임 수 (FixedContextualException)
+    virtual void AddOmittedFrames(std::size_t count) {
+        (void)count;
+    }
+
+   protected:
+    ~FrameSink() {}
+};
+
+// 감싸질 때 RTTI 없이 프레임을 제공하는 예외의 인터페이스
+// - ContextualException, FixedContextualException 이 구현
+// - 직접 만든 예외도 std::exception 파생 타입과 함께 상속 후 VisitFrames 를
+//   구현하면 프레임이 보존됨 (struct MyError : std::runtime_error, FrameSource)
+// - 정적 타입이 FrameSource 파생이면 오버로드로 선택되어 캐스트 없음,
+//   std::exception 으로만 알 때는 타입당 dynamic_cast 1회 (AsFrameSource,
+//   RTTI 비활성화 시 what() 만)
+class FrameSource {
+   public:
+    virtual void VisitFrames(FrameSink* sink) const = 0;
+
+   protected:
+    ~FrameSource() {}
+};
+
+namespace anonymous {
+
+// FrameSource 를 받는 오버로드용 (Source 가 FrameSource 파생일 때만 선택)
+// - std::exception 도 상속한 타입은 두 기반 클래스 참조 오버로드가 모호하므로
+//   정확히 일치하는 템플릿으로 우선 선택되게 함
+template <typename Source>
+using EnableIfFrameSource = typename std::enable_if<
+    std::is_base_of<FrameSource, Source>::value>::type;
+
+// exception 이 FrameSource 이면 그 포인터 (RTTI 비활성화 시 항상 nullptr)
+// - 최종 파생 타입의 type_info 주소별로 결과를 캐시해 dynamic_cast(계층 탐색,
+//   라이브러리 경계에서는 이름 비교)를 타입당 1회로 (최대 64 타입, 넘으면
+//   나머지 타입은 매번 dynamic_cast)
+// - FrameSource 이면 최종 파생 객체에서의 위치를 캐시 (std::exception 기반이
+//   여럿이어도 최종 파생 객체 안의 위치는 타입마다 고정)
+inline const FrameSource* AsFrameSource(const std::exception& exception) {
+#if defined(__GXX_RTTI) || defined(_CPPRTTI)
+    struct Slot {
+        // 0: 비어 있음, kWriting: 다른 스레드가 기록 중
+        std::atomic<std::uintptr_t> type;
+        // 최종 파생 객체에서 FrameSource 까지 (kNotFrameSource: 아님)
+        std::atomic<std::ptrdiff_t> offset;
+    };
+    enum { kSlots = 64 };
+    static const std::uintptr_t kWriting = 1;
+    static const std::ptrdiff_t kNotFrameSource = PTRDIFF_MIN;
+    static Slot slots[kSlots];
+
+    const char* const object =
+        static_cast<const char*>(dynamic_cast<const void*>(&exception));
+    const std::uintptr_t type =
+        reinterpret_cast<std::uintptr_t>(&typeid(exception));
+    Slot* empty_slot = nullptr;
+    for (std::size_t probe = 0; probe < kSlots; ++probe) {
+        Slot& slot = slots[(type / sizeof(void*) + probe) % kSlots];
+        const std::uintptr_t value = slot.type.load(std::memory_order_acquire);
+        if (type == value) {
+            const std::ptrdiff_t offset =
+                slot.offset.load(std::memory_order_relaxed);
+            return kNotFrameSource == offset
+                       ? nullptr
+                       : reinterpret_cast<const FrameSource*>(object + offset);
+        }
+        if (0 == value) {
+            empty_slot = &slot;
+            break;
+        }
+    }
+    const FrameSource* source = dynamic_cast<const FrameSource*>(&exception);
+    std::uintptr_t empty = 0;
+    // 다른 스레드가 먼저 차지했으면 이번에는 기록하지 않음
+    if (empty_slot && empty_slot->type.compare_exchange_strong(
+                          empty, kWriting, std::memory_order_relaxed)) {
+        empty_slot->offset.store(
+            source ? reinterpret_cast<const char*>(source) - object
+                   : kNotFrameSource,
+            std::memory_order_relaxed);
+        empty_slot->type.store(type, std::memory_order_release);
+    }
+    return source;
+#else
+    (void)exception;
+    return nullptr;
+#endif
+}
+
+#if defined(__GXX_RTTI) || defined(_CPPRTTI)
+
+// exception_ptr 이 가리키는 std::exception 을 다시 던지지 않고 얻음
+// (std::exception 이 아니면 nullptr)
+#if defined(__cpp_lib_exception_ptr_cast)
+#define __CONTEXTUAL_PEEK_EXCEPTION_PTR
+inline const std::exception* PeekException(
+    const std::exception_ptr& exception) {
+    return std::exception_ptr_cast<std::exception>(exception);
+}
+#elif defined(__GLIBCXX__)
+#define __CONTEXTUAL_PEEK_EXCEPTION_PTR
+// libstdc++: exception_ptr 은 던져진 객체의 주소 하나 (고정된 ABI)
+// - catch 절과 같은 방식(type_info::__do_catch)으로 std::exception 변환
+inline const std::exception* PeekException(
+    const std::exception_ptr& exception) {
+    static_assert(sizeof(std::exception_ptr) == sizeof(void*),
+                  "unexpected exception_ptr layout");
+    if (!exception) {
+        return nullptr;
+    }
+    void* object = nullptr;
+    std::memcpy(&object, &exception, sizeof(object));
+    if (!typeid(std::exception)
+             .__do_catch(exception.__cxa_exception_type(), &object, 1)) {
+        return nullptr;
+    }
+    return static_cast<const std::exception*>(object);
+}
+#endif
+
+// std::nested_exception 한 단계를 sink 에 전달하고 다음 단계를 반환
+// - FrameSource 이면 그 프레임들
+// - 그 외에는 what() 을 메시지로 하는 위치 정보 없는 프레임 1개
+// (FrameSource 도 std::throw_with_nested 로 던져졌으면 다음 단계가 있음)
+inline const std::nested_exception* AddNestedFrame(
+    const std::exception& exception, FrameSink* sink) {
+    const FrameSource* source = AsFrameSource(exception);
+    if (source) {
+        source->VisitFrames(sink);
+    } else {
+        static const SourceSite unknown_site = {"", "", 0, nullptr};
+        const int default_code = 0;
+        sink->AddFrame(exception.what(), default_code, unknown_site);
+    }
+    return dynamic_cast<const std::nested_exception*>(&exception);
+}
+
+// nested 가 보관한 예외부터 안쪽으로 단계마다 프레임을 sink 에 전달
+// (std::exception 이 아닌 단계에서 종료)
+// - 가능한 환경에서는 다시 던지지 않고 순회
+//   (그 외에는 단계마다 rethrow_exception + catch, 단계당 수 us)
+inline void VisitNestedFrames(const std::nested_exception& nested,
+                              FrameSink* sink) {
+#if defined(__CONTEXTUAL_PEEK_EXCEPTION_PTR)
+    std::exception_ptr pointer = nested.nested_ptr();
+    while (pointer) {
+        const std::exception* exception = PeekException(pointer);
+        const std::nested_exception* next =
+            exception ? AddNestedFrame(*exception, sink) : nullptr;
+        pointer = next ? next->nested_ptr() : nullptr;
+    }
+#else
+    const std::exception_ptr pointer = nested.nested_ptr();
+    if (!pointer) {
+        return;
+    }
+    try {
+        std::rethrow_exception(pointer);
+    } catch (const std::exception& exception) {
+        // 다시 던진 객체가 복사본일 수 있으므로 catch 안에서 순회
+        const std::nested_exception* next = AddNestedFrame(exception, sink);
+        if (next) {
+            VisitNestedFrames(*next, sink);
+        }
+    } catch (...) {
+    }
+#endif
+}
+
+// source 가 std::throw_with_nested 로 던져졌으면 (std::nested_exception 도
+// 상속) 중첩된 예외들의 프레임을 이어서 sink 에 전달
+// (typeid 가 Exact 이면 중첩되지 않았으므로 dynamic_cast 생략)
+template <typename Exact>
+inline void VisitNestedSourceFrames(const FrameSource& source,
+                                    FrameSink* sink) {
+    if (typeid(source) == typeid(Exact)) {
+        return;
+    }
+    const std::nested_exception* nested =
+        dynamic_cast<const std::nested_exception*>(&source);
+    if (nested) {
+        VisitNestedFrames(*nested, sink);
+    }
+}
+
+#endif
+
+// source 의 프레임에 이어 std::throw_with_nested 로 중첩된 예외들의 프레임까지
+// sink 에 전달 (감쌀 때, DetailedErrorMessage 와 같은 범위)
+// (RTTI 비활성화 시 source 의 프레임만)
+template <typename Source>
+inline void VisitSourceFrames(const Source& source, FrameSink* sink) {
+    source.VisitFrames(sink);
+#if defined(__GXX_RTTI) || defined(_CPPRTTI)
+    VisitNestedSourceFrames<Source>(source, sink);
+#endif
+}
+
+}  // namespace anonymous
+}  // namespace contextual_exception
+
+class ContextualException : public std::exception,
+                            public contextual_exception::FrameSource {
+   public:
+    typedef contextual_exception::SourceSite SourceSite;
+    typedef contextual_exception::FrameSource FrameSource;
+
     // 추적 프레임
     struct Frame {
         std::string message;
         int code;
 
-        std::string file;
-        int line;
-        std::string function;
+        // 항상 유효 (정적 레코드 또는 InternSourceSite 레코드)
+        const SourceSite* site;
 
-        int depth;
+        // 지연 포맷 메시지 (있으면 message 대신 사용)
+        std::shared_ptr<const contextual_exception::FormattedMessage>
+            formatted_message;
 
-        Frame() : code(0), line(0), depth(0) {}
+        Frame() : code(0), site(&EmptySite()) {}
+        Frame(const std::string& message, int code, const SourceSite& site)
+            : message(message), code(code), site(&site) {}
+        // 런타임 문자열 위치 정보 (InternSourceSite 로 등록)
         Frame(const std::string& message, int code, const std::string& file,
               int line, const std::string& function)
             : message(message),
               code(code),
-              file(file),
-              line(line),
-              function(function),
-              depth(0) {}
+              site(&contextual_exception::InternSourceSite(file, line,
+                                                           function)) {}
+        Frame(std::shared_ptr<const contextual_exception::FormattedMessage>
+                  formatted_message,
+              int code, const SourceSite& site)
+            : code(code),
+              site(&site),
+              formatted_message(std::move(formatted_message)) {}
+
+        // 지연 포맷 메시지는 최초 호출 시 렌더링
+        const std::string& Message() const CONTEXTUAL_EXCEPTION_NOEXCEPT {
+            if (formatted_message) {
+                const std::string* rendered = formatted_message->Rendered();
+                if (rendered) {
+                    return *rendered;
+                }
+            }
+            return message;
+        }
+        // 렌더링, 할당 없이 얻을 수 있는 메시지 (비동기 시그널 안전)
+        // (아직 렌더링되지 않은 지연 포맷 메시지는 형식 문자열)
+        const char* AvailableMessage() const CONTEXTUAL_EXCEPTION_NOEXCEPT {
+            if (formatted_message) {
+                const std::string* rendered = formatted_message->Peek();
+                return rendered ? rendered->c_str()
+                                : formatted_message->Format();
+            }
+            return message.c_str();
+        }
+    };
+
+    struct FrameNode;
+    typedef contextual_exception::anonymous::IntrusivePointer<const FrameNode>
+        FrameChain;
+
+    // 불변 프레임 체인 노드
+    // - 첫 노드가 기본 프레임, 이후 노드가 하위 프레임
+    // - 감싸는 예외는 하위 예외의 체인을 복사하지 않고 공유 (O(1) wrap)
+    // - 예외 객체는 첫 노드 포인터만 보유하므로 복사는 참조 카운트 증가 1회
+    // - depth 는 저장하지 않고 순회 위치로 계산
+    struct FrameNode {
+        Frame frame;
+        FrameChain next;
+
+        // 이 노드가 첫 노드인 예외의 what() (복사본끼리 공유)
+        contextual_exception::anonymous::LazyString error_message;
+        mutable std::atomic<long> reference_count;
+
+        FrameNode(Frame&& frame, FrameChain next)
+            : frame(std::move(frame)),
+              next(std::move(next)),
+              reference_count(1) {}
+        FrameNode(const FrameNode&) = delete;
+        FrameNode& operator=(const FrameNode&) = delete;
+
+        // 긴 체인의 재귀 소멸로 스택이 넘치지 않도록 단독 소유 구간을 반복 해제
+        ~FrameNode() {
+            const FrameNode* node = next.release();
+            while (node && FrameChain::Unreference(node)) {
+                const FrameNode* following =
+                    const_cast<FrameNode*>(node)->next.release();
+                delete node;
+                node = following;
+            }
+        }
     };
 
    public:
     ContextualException() {}
-    ContextualException(const std::string& message, const std::string& file,
-                        int line, const std::string& function) {
+    ContextualException(const std::string& message, const SourceSite& site) {
         const int default_code = 0;
-        SetBaseFrame(message, default_code, file, line, function);
-        AssignErrorMessage();
+        InitializeFrames(Frame(message, default_code, site), nullptr);
     }
     ContextualException(const std::string& message, int code,
-                        const std::string& file, int line,
-                        const std::string& function) {
-        SetBaseFrame(message, code, file, line, function);
-        AssignErrorMessage();
+                        const SourceSite& site) {
+        InitializeFrames(Frame(message, code, site), nullptr);
     }
     ContextualException(const std::string& message,
                         const std::exception& exception,
-                        const std::string& file, int line,
-                        const std::string& function) {
+                        const SourceSite& site) {
         const int default_code = 0;
-        SetBaseFrame(message, default_code, file, line, function);
-        WrapException(exception);
-        AssignErrorMessage();
+        Frame base_frame(message, default_code, site);
+        FrameChain child_frames = WrapException(exception, &base_frame);
+        InitializeFrames(std::move(base_frame), std::move(child_frames));
+    }
+    ContextualException(const std::string& message, int code,
+                        const std::exception& exception,
+                        const SourceSite& site) {
+        Frame base_frame(message, code, site);
+        FrameChain child_frames = WrapException(exception, &base_frame);
+        InitializeFrames(std::move(base_frame), std::move(child_frames));
+    }
+
+    // 정적 타입이 FrameSource 파생이면 캐스트 없이 프레임을 넘겨받음
+    template <typename Source, typename = contextual_exception::anonymous::
+                                   EnableIfFrameSource<Source>>
+    ContextualException(const std::string& message, const Source& source,
+                        const SourceSite& site) {
+        const int default_code = 0;
+        InitializeFrames(Frame(message, default_code, site),
+                         CollectFrames(source));
     }
+    template <typename Source, typename = contextual_exception::anonymous::
+                                   EnableIfFrameSource<Source>>
     ContextualException(const std::string& message, int code,
+                        const Source& source, const SourceSite& site) {
+        InitializeFrames(Frame(message, code, site), CollectFrames(source));
+    }
+
+    // 지연 포맷 메시지 (CONTEXTUAL_EXCEPTION_F 참고)
+    ContextualException(
+        std::shared_ptr<const contextual_exception::FormattedMessage> message,
+        int code, const SourceSite& site) {
+        InitializeFrames(Frame(std::move(message), code, site), nullptr);
+    }
+
+    // format 은 리터럴이어야 함 (복사하지 않고 포인터만 보관)
+    template <typename... Values>
+    static ContextualException MakeFormatted(const SourceSite& site, int code,
+                                             const char* format,
+                                             Values&&... values) {
+        typedef contextual_exception::BasicFormattedMessage<
+            typename contextual_exception::anonymous::FormatStorage<
+                Values>::type...>
+            Message;
+        return ContextualException(std::make_shared<const Message>(
+                                       format, std::forward<Values>(values)...),
+                                   code, site);
+    }
+
+    // 기본 프레임부터 순서대로 나열된 프레임으로 예외 복원 (역직렬화 등)
+    // - 새로 발생한 예외가 아니므로 호출 지점 카운터에 기록하지 않음
+    static ContextualException FromFrames(std::vector<Frame> frames) {
+        ContextualException exception;
+        exception.frames_ = LinkFrames(&frames, nullptr);
+        exception.AssignErrorMessage();
+        return exception;
+    }
+    // source 의 프레임을 그대로 가진 예외 (ContextualException 이면 체인 공유)
+    static ContextualException FromSource(const FrameSource& source) {
+        ContextualException exception;
+        exception.frames_ = CollectFrames(source);
+        exception.AssignErrorMessage();
+        return exception;
+    }
+
+    // 하위 ContextualException 의 체인 소유권을 그대로 넘겨받음
+    ContextualException(const std::string& message,
+                        ContextualException&& exception,
+                        const SourceSite& site) {
+        const int default_code = 0;
+        InitializeFrames(Frame(message, default_code, site),
+                         std::move(exception.frames_));
+    }
+    ContextualException(const std::string& message, int code,
+                        ContextualException&& exception,
+                        const SourceSite& site) {
+        InitializeFrames(Frame(message, code, site),
+                         std::move(exception.frames_));
+    }
+
+    // 런타임 문자열 위치 정보 (InternSourceSite 로 등록)
+    ContextualException(const std::string& message, const std::string& file,
+                        int line, const std::string& function)
+        : ContextualException(
+              message,
+              contextual_exception::InternSourceSite(file, line, function)) {}
+    ContextualException(const std::string& message, int code,
+                        const std::string& file, int line,
+                        const std::string& function)
+        : ContextualException(
+              message, code,
+              contextual_exception::InternSourceSite(file, line, function)) {}
+    ContextualException(const std::string& message,
                         const std::exception& exception,
                         const std::string& file, int line,
-                        const std::string& function) {
-        SetBaseFrame(message, code, file, line, function);
-        WrapException(exception);
-        AssignErrorMessage();
+                        const std::string& function)
+        : ContextualException(
+              message, exception,
+              contextual_exception::InternSourceSite(file, line, function)) {}
+    ContextualException(const std::string& message, int code,
+                        const std::exception& exception,
+                        const std::string& file, int line,
+                        const std::string& function)
+        : ContextualException(
+              message, code, exception,
+              contextual_exception::InternSourceSite(file, line, function)) {}
+
+    // 복사는 체인(렌더링된 what() 포함)을 공유 (참조 카운트 증가 1회)
+    ContextualException(const ContextualException& other)
+        : std::exception(other), FrameSource(other), frames_(other.frames_) {}
+    ContextualException(ContextualException&& other)
+        CONTEXTUAL_EXCEPTION_NOEXCEPT
+        : std::exception(other),
+          FrameSource(other),
+          frames_(std::move(other.frames_)) {}
+
+    ContextualException& operator=(const ContextualException& other) {
+        frames_ = other.frames_;
+        return *this;
+    }
+    ContextualException& operator=(ContextualException&& other)
+        CONTEXTUAL_EXCEPTION_NOEXCEPT {
+        frames_ = std::move(other.frames_);
+        return *this;
     }
 
     virtual ~ContextualException() CONTEXTUAL_EXCEPTION_NOEXCEPT {};
 
    public:
+    // 렌더링 실패(메모리 부족) 시에도 예외를 던지지 않고 원본 메시지를 반환
     virtual const char* what() const CONTEXTUAL_EXCEPTION_NOEXCEPT override {
-        return error_message_.c_str();
+        const std::string* error_message = RenderErrorMessage();
+        if (!error_message) {
+            return BaseFrame().Message().c_str();
+        }
+        return error_message->c_str();
     }
 
    public:
     const std::string& Message() const {
-        return base_frame_.message;
+        return BaseFrame().Message();
     }
     int Code() const {
-        return base_frame_.code;
+        return BaseFrame().code;
     }
 
-    const std::string& File() const {
-        return base_frame_.file;
+    // 할당 없이 얻으려면 BaseFrame().site 사용
+    std::string File() const {
+        return BaseFrame().site->file;
     }
     int Line() const {
-        return base_frame_.line;
+        return BaseFrame().site->line;
     }
-    const std::string& Function() const {
-        return base_frame_.function;
+    std::string Function() const {
+        return BaseFrame().site->function;
+    }
+
+    const Frame& BaseFrame() const {
+        return frames_ ? frames_->frame : EmptyFrame();
+    }
+    // 하위 프레임 체인 (없으면 nullptr)
+    const FrameNode* ChildFrames() const {
+        return frames_ ? frames_->next.get() : nullptr;
     }
 
     std::string DetailedErrorMessage() const {
-        std::ostringstream stream;
-        stream << error_message_;
+        std::string detailed_error_message;
+        detailed_error_message.reserve(WriteDetailedErrorMessage(nullptr, 0));
+        AppendDetailedErrorMessage(
+            [&detailed_error_message](const char* data, std::size_t size) {
+                detailed_error_message.append(data, size);
+            });
+        return detailed_error_message;
+    }
+
+    // DetailedErrorMessage() 를 중간 문자열 없이 출력 대상에 직접 기록
+    // (what() 이후로는 임시 할당 없음)
+    void WriteDetailedErrorMessage(std::ostream& stream) const {
+        AppendDetailedErrorMessage([&stream](const char* data,
+                                             std::size_t size) {
+            stream.write(data, static_cast<std::streamsize>(size));
+        });
+    }
+    // buffer 에 NUL 종료로 기록하고 잘리지 않았다면 필요한 길이를 반환
+    // (snprintf 와 같은 규칙)
+    std::size_t WriteDetailedErrorMessage(char* buffer,
+                                          std::size_t capacity) const {
+        contextual_exception::anonymous::BufferWriter writer(buffer, capacity);
+        WriteDetailedErrorMessageTo(&writer);
+        return writer.RequiredSize();
+    }
+    // 조각마다 append(const char* data, std::size_t size) 호출
+    template <typename Append>
+    void AppendDetailedErrorMessage(const Append& append) const {
+        contextual_exception::anonymous::AppendWriter<Append> writer(append);
+        WriteDetailedErrorMessageTo(&writer);
+    }
+
+   public:
+    // 새 컨텍스트 프레임을 기본 프레임으로 올리고 기존 체인은 하위로 공유
+    // catch (ContextualException& e) { e.AddContext(...); throw; } 처럼
+    // 새 예외를 만들지 않고 원본 객체를 그대로 다시 던질 때 사용
+    // (다른 스레드가 같은 객체의 what() 을 읽는 중에는 호출하지 말 것)
+    void AddContext(const std::string& message, const SourceSite& site) {
+        const int default_code = 0;
+        AddContext(message, default_code, site);
+    }
+    void AddContext(const std::string& message, int code,
+                    const SourceSite& site) {
+        SetFrames(Frame(message, code, site), std::move(frames_));
+        AssignErrorMessage();
+    }
+    // 지연 포맷 메시지 버전 (format 은 리터럴)
+    template <typename... Values>
+    void AddFormattedContext(const SourceSite& site, int code,
+                             const char* format, Values&&... values) {
+        typedef contextual_exception::BasicFormattedMessage<
+            typename contextual_exception::anonymous::FormatStorage<
+                Values>::type...>
+            Message;
+        SetFrames(Frame(std::make_shared<const Message>(
+                            format, std::forward<Values>(values)...),
+                        code, site),
+                  std::move(frames_));
+        AssignErrorMessage();
+    }
 
-        auto size_frames = child_frames_.size();
-        for (size_t ii = 0; ii < size_frames; ++ii) {
-            stream << "\n    " << GetFrameMessage(child_frames_[ii]);
+    // 자신의 프레임만 새로 만들고 exception 의 체인은 그대로 공유
+    void AppendException(const ContextualException& exception) {
+        std::vector<const Frame*> own_frames;
+        own_frames.push_back(&BaseFrame());
+        for (const FrameNode* node = ChildFrames(); node;
+             node = node->next.get()) {
+            own_frames.push_back(&node->frame);
         }
 
-        return stream.str();
+        FrameChain frames = exception.frames_;
+        for (auto it = own_frames.rbegin(); it != own_frames.rend(); ++it) {
+            frames = FrameChain(new FrameNode(Frame(**it), std::move(frames)));
+        }
+        frames_ = std::move(frames);
     }
 
    public:
-    void AppendException(const ContextualException& exception) {
-        AppendFramesFrom(exception);
-        NormalizeChildDepth();
+    // FrameSource: 체인 전체를 넘김 (감싸는 ContextualException 은 공유)
+    virtual void VisitFrames(
+        contextual_exception::FrameSink* sink) const override {
+        sink->AddFrames(*this);
     }
 
    private:
-    void SetBaseFrame(const std::string& message, int code,
-                      const std::string& file, int line,
-                      const std::string& function) {
-        base_frame_ = Frame(message, code, file, line, function);
+    // FrameSource 가 전달한 프레임으로 하위 체인 구성
+    class ChainBuilder : public contextual_exception::FrameSink {
+       public:
+        virtual void AddFrame(const char* message, int code,
+                              const SourceSite& site) override {
+            FlushTail();
+            frames_.push_back(Frame(message, code, site));
+        }
+        virtual void AddFrames(const ContextualException& exception) override {
+            FlushTail();
+            tail_ = exception.frames_;
+        }
+
+        FrameChain Chain() {
+            return LinkFrames(&frames_, std::move(tail_));
+        }
+
+       private:
+        // 공유 중인 체인 뒤에 프레임이 더 오면 (중첩된 예외) 복사해 이어 붙임
+        void FlushTail() {
+            if (CONTEXTUAL_LIKELY(!tail_)) {
+                return;
+            }
+            for (const FrameNode* node = tail_.get(); node;
+                 node = node->next.get()) {
+                frames_.push_back(node->frame);
+            }
+            tail_ = nullptr;
+        }
+
+        std::vector<Frame> frames_;
+        FrameChain tail_;
+    };
+
+    // frames 를 순서대로 이어 tail 앞에 붙인 체인 (frames 는 이동됨)
+    static FrameChain LinkFrames(std::vector<Frame>* frames, FrameChain tail) {
+        FrameChain chain = std::move(tail);
+        for (auto it = frames->rbegin(); it != frames->rend(); ++it) {
+            chain = FrameChain(new FrameNode(std::move(*it), std::move(chain)));
+        }
+        return chain;
+    }
+
+    // 새 예외의 프레임 설정 (호출 지점 카운터 기록, 범위 컨텍스트 부착)
+    void InitializeFrames(Frame&& base_frame, FrameChain child_frames) {
+        contextual_exception::anonymous::RecordSite(*base_frame.site,
+                                                    base_frame.code);
+        if (!child_frames) {
+            const contextual_exception::ScopeContext* scope =
+                contextual_exception::ScopeContext::Current();
+            if (CONTEXTUAL_UNLIKELY(scope)) {
+                child_frames = ScopeFrames(scope);
+            }
+        }
+        SetFrames(std::move(base_frame), std::move(child_frames));
+        AssignErrorMessage();
+    }
+
+    // scope 부터 바깥쪽으로 범위마다 프레임 1개
+    static FrameChain ScopeFrames(
+        const contextual_exception::ScopeContext* scope) {
+        const int default_code = 0;
+        std::vector<Frame> frames;
+        for (; scope; scope = scope->Previous()) {
+            frames.push_back(
+                Frame(scope->MakeMessage(), default_code, scope->Site()));
+        }
+        return LinkFrames(&frames, nullptr);
+    }
+
+    void SetFrames(Frame&& base_frame, FrameChain child_frames) {
+        frames_ = FrameChain(
+            new FrameNode(std::move(base_frame), std::move(child_frames)));
     }
 
     void AssignErrorMessage() {
-        error_message_ = GetFrameMessage(base_frame_);
+#if defined(CONTEXTUAL_EXCEPTION_EAGER_WHAT)
+        RenderErrorMessage();
+#endif
     }
 
-    void WrapException(const std::exception& exception) {
-        if (IsContextualException(exception)) {
-            AppendFramesFrom(exception);
-        } else {
-            WrapOtherException(exception);
+    const std::string* RenderErrorMessage() const
+        CONTEXTUAL_EXCEPTION_NOEXCEPT {
+        if (!frames_) {
+            return nullptr;
+        }
+        return frames_->error_message.Get([this](std::string* output) {
+            *output = GetFrameMessage(BaseFrame());
+        });
+    }
+
+    // FrameSource 이면 프레임을 넘겨받고, 아니면 기본 프레임 메시지에 병합
+    // (std::nested_exception 이면 어느 쪽이든 중첩된 예외들은 하위 프레임)
+    // (가장 흔한 ContextualException 자체는 typeid 비교만으로 체인 공유)
+    static FrameChain WrapException(const std::exception& exception,
+                                    Frame* base_frame) {
+#if defined(__GXX_RTTI) || defined(_CPPRTTI)
+        if (typeid(exception) == typeid(ContextualException)) {
+            return static_cast<const ContextualException&>(exception).frames_;
+        }
+#endif
+        const FrameSource* source =
+            contextual_exception::anonymous::AsFrameSource(exception);
+        if (source) {
+            return CollectFrames(*source);
         }
-        NormalizeChildDepth();
+        WrapOtherException(exception, base_frame);
+        return WrapNestedException(exception);
     }
-    void AppendFramesFrom(const std::exception& exception) {
-        const auto* origin_exception =
-            dynamic_cast<const ContextualException*>(&exception);
-        child_frames_.emplace_back(origin_exception->base_frame_);
-        child_frames_.insert(child_frames_.end(),
-                             origin_exception->child_frames_.begin(),
-                             origin_exception->child_frames_.end());
+    static FrameChain CollectFrames(const FrameSource& source) {
+        ChainBuilder builder;
+        source.VisitFrames(&builder);
+#if defined(__GXX_RTTI) || defined(_CPPRTTI)
+        contextual_exception::anonymous::VisitNestedSourceFrames<
+            ContextualException>(source, &builder);
+#endif
+        return builder.Chain();
     }
-    void WrapOtherException(const std::exception& exception) {
-        auto& frame = base_frame_;
+    // std::throw_with_nested 로 중첩된 예외는 단계마다 하위 프레임
+    static FrameChain WrapNestedException(const std::exception& exception) {
+#if defined(__GXX_RTTI) || defined(_CPPRTTI)
+        const std::nested_exception* nested =
+            dynamic_cast<const std::nested_exception*>(&exception);
+        if (nested) {
+            ChainBuilder builder;
+            contextual_exception::anonymous::VisitNestedFrames(*nested,
+                                                               &builder);
+            return builder.Chain();
+        }
+#else
+        (void)exception;
+#endif
+        return nullptr;
+    }
+    static void WrapOtherException(const std::exception& exception,
+                                   Frame* base_frame) {
+        auto& frame = *base_frame;
         if (frame.message.empty()) {
             frame.message = exception.what();
         } else {
@@ -162,118 +1691,356 @@ class ContextualException : public std::exception {
         }
     }
 
-    static bool IsContextualException(const std::exception& exception) {
-        return dynamic_cast<const ContextualException*>(&exception) != nullptr;
+    static const SourceSite& EmptySite() {
+        static const SourceSite empty_site = {"", "", 0, nullptr};
+        return empty_site;
+    }
+    static const Frame& EmptyFrame() {
+        static const Frame empty_frame;
+        return empty_frame;
     }
 
-    std::string GetFrameMessage(const Frame& frame) const {
-        std::ostringstream stream;
-        stream << frame.file << ":" << frame.line << " | " << frame.function
-               << "() | ";
-        if (0 != frame.code) {
-            stream << "[code=" << frame.code << "] ";
+    template <typename Writer>
+    void WriteDetailedErrorMessageTo(Writer* writer) const {
+        writer->Append(what());
+        for (const FrameNode* node = ChildFrames(); node;
+             node = node->next.get()) {
+            writer->Append("\n    ");
+            WriteFrame(writer, node->frame);
         }
-        stream << frame.message;
-        return stream.str();
     }
 
-    void NormalizeChildDepth() {
-        auto size_frames = child_frames_.size();
-        for (size_t ii = 0; ii < size_frames; ++ii) {
-            child_frames_[ii].depth = static_cast<int>(ii) + 1;
-        }
+    template <typename Writer>
+    static void WriteFrame(Writer* writer, const Frame& frame) {
+        contextual_exception::anonymous::WriteFrameText(
+            writer, *frame.site, frame.code, frame.Message());
+    }
+
+    static std::string GetFrameMessage(const Frame& frame) {
+        // 길이를 먼저 세어 1회 할당
+        contextual_exception::anonymous::BufferWriter counter(nullptr, 0);
+        WriteFrame(&counter, frame);
+
+        std::string frame_message;
+        frame_message.reserve(counter.RequiredSize());
+        const auto append = [&frame_message](const char* data,
+                                             std::size_t size) {
+            frame_message.append(data, size);
+        };
+        contextual_exception::anonymous::AppendWriter<decltype(append)> writer(
+            append);
+        WriteFrame(&writer, frame);
+        return frame_message;
     }
 
    private:
-    Frame base_frame_;
-    std::vector<Frame> child_frames_;
-    std::string error_message_;
+    FrameChain frames_;
 };
 
 namespace contextual_exception {
+
+// exception 의 프레임 체인을 std::nested_exception 단계로 변환
+// - 프레임마다 한 단계 (프레임 1개인 ContextualException, code 유지)
+//   기본 프레임이 가장 바깥 단계, 안쪽 단계는 std::throw_with_nested 로 보관
+// - std::rethrow_if_nested 로 순회하는 코드에 넘길 때 사용
+//   (단계마다 throw/catch 하므로 실패 경로 전용)
+// - 결과를 다시 감싸면 바깥 단계의 프레임만 남으므로 ContextualException 을
+//   받는 코드에는 원래 예외를 넘길 것
+// usecase)
+//   std::rethrow_exception(contextual_exception::MakeNestedException(e));
+inline std::exception_ptr MakeNestedException(const FrameSource& exception) {
+    typedef ::ContextualException::Frame Frame;
+    const ::ContextualException chain =
+        ::ContextualException::FromSource(exception);
+    std::vector<const Frame*> frames(1, &chain.BaseFrame());
+    for (const ::ContextualException::FrameNode* node = chain.ChildFrames();
+         node; node = node->next.get()) {
+        frames.push_back(&node->frame);
+    }
+
+    std::exception_ptr nested;
+    for (auto it = frames.rbegin(); it != frames.rend(); ++it) {
+        const ::ContextualException level =
+            ::ContextualException::FromFrames(std::vector<Frame>(1, **it));
+        try {
+            if (!nested) {
+                throw level;
+            }
+            try {
+                std::rethrow_exception(nested);
+            } catch (...) {
+                std::throw_with_nested(level);
+            }
+        } catch (...) {
+            nested = std::current_exception();
+        }
+    }
+    return nested;
+}
+
 namespace anonymous {
 
-inline ContextualException Make(const char* file, int line,
-                                const char* function,
+inline ContextualException Make(const SourceSite& site,
                                 const std::string& message) {
-    return ContextualException(message, file, line, function);
+    return ContextualException(message, site);
 }
 
-inline ContextualException Make(const char* file, int line,
-                                const char* function,
+inline ContextualException Make(const SourceSite& site,
                                 const std::string& message, int code) {
-    return ContextualException(message, code, file, line, function);
+    return ContextualException(message, code, site);
+}
+
+// Source: 호출 지점의 정적 타입 (FrameSource 파생이면 캐스트 없는 생성자 선택)
+template <typename Source>
+inline ContextualException Wrap(const SourceSite& site,
+                                const std::string& message,
+                                const Source& exception) {
+    return ContextualException(message, exception, site);
+}
+
+template <typename Source>
+inline ContextualException Wrap(const SourceSite& site,
+                                const std::string& message, int code,
+                                const Source& exception) {
+    return ContextualException(message, code, exception, site);
 }
 
-inline ContextualException Wrap(const char* file, int line,
-                                const char* function,
+inline ContextualException Wrap(const SourceSite& site,
                                 const std::string& message,
-                                const std::exception& exception) {
-    return ContextualException(message, exception, file, line, function);
+                                ContextualException&& exception) {
+    return ContextualException(message, std::move(exception), site);
 }
 
-inline ContextualException Wrap(const char* file, int line,
-                                const char* function,
+inline ContextualException Wrap(const SourceSite& site,
                                 const std::string& message, int code,
-                                const std::exception& exception) {
-    return ContextualException(message, code, exception, file, line, function);
+                                ContextualException&& exception) {
+    return ContextualException(message, code, std::move(exception), site);
 }
 
 inline ContextualException* SafeChain(
-    const char* file, int line, const char* function,
-    const std::string& message, ContextualException* source_exception_or_null) {
+    const SourceSite& site, const std::string& message,
+    ContextualException* source_exception_or_null) {
     if (!source_exception_or_null) {
         return nullptr;
     }
 
-    ContextualException lower_exception = std::move(*source_exception_or_null);
-    *source_exception_or_null =
-        ContextualException(message, file, line, function);
-    source_exception_or_null->AppendException(lower_exception);
+    source_exception_or_null->AddContext(message, site);
 
     return source_exception_or_null;
 }
 
 inline ContextualException* SafeChain(
-    const char* file, int line, const char* function,
-    const std::string& message, int code,
+    const SourceSite& site, const std::string& message, int code,
     ContextualException* source_exception_or_null) {
     if (!source_exception_or_null) {
         return nullptr;
     }
 
-    ContextualException lower_exception = std::move(*source_exception_or_null);
-    *source_exception_or_null =
-        ContextualException(message, code, file, line, function);
-    source_exception_or_null->AppendException(lower_exception);
+    source_exception_or_null->AddContext(message, code, site);
 
     return source_exception_or_null;
 }
 
+// Placeholders: 컴파일 시점에 계산된 형식 문자열의 {} 개수
+template <int Placeholders, typename... Values>
+inline ContextualException MakeFormatted(const SourceSite& site, int code,
+                                         const char* format,
+                                         Values&&... values) {
+    static_assert(FormatArgumentsCheck<Placeholders, sizeof...(Values)>::value,
+                  "invalid format arguments");
+    return ContextualException::MakeFormatted(site, code, format,
+                                              std::forward<Values>(values)...);
+}
+
+inline ContextualException& AddContext(ContextualException& exception,
+                                       const SourceSite& site,
+                                       const std::string& message) {
+    exception.AddContext(message, site);
+    return exception;
+}
+
+inline ContextualException& AddContext(ContextualException& exception,
+                                       const SourceSite& site,
+                                       const std::string& message, int code) {
+    exception.AddContext(message, code, site);
+    return exception;
+}
+
+// THROW_* 매크로 식의 타입 (throw 함수가 반환하지 않으므로 실제 값은 없음)
+// - 어떤 타입으로도 변환되어 throw 식과 같이 ?: 의 피연산자 등에 사용 가능
+//   (예: int value = found ? *found : THROW_CONTEXTUAL_EXCEPTION("..."))
+// - void 로는 변환되지 않음 (진짜 throw 식은 호출 지점마다 예외 객체 할당
+//   코드가 생겨 쓰지 않음)
+struct ThrowExpression {
+    template <typename Value>
+    operator Value() const {
+        std::terminate();
+    }
+};
+
+// THROW_* 매크로용 throw 함수
+// - 호출 지점에는 인자 전달과 call 만 남도록 예외 생성을 함수 밖으로 분리
+// - 리터럴 메시지는 const char* 로 받아 호출 지점에서 std::string 을 만들지 않음
+template <typename Exception>
+[[noreturn]] CONTEXTUAL_EXCEPTION_COLD ThrowExpression Throw(
+    const SourceSite& site, const char* message) {
+    throw Exception(message, site);
+}
+
+template <typename Exception>
+[[noreturn]] CONTEXTUAL_EXCEPTION_COLD ThrowExpression Throw(
+    const SourceSite& site, const std::string& message) {
+    throw Exception(message, site);
+}
+
+template <typename Exception>
+[[noreturn]] CONTEXTUAL_EXCEPTION_COLD ThrowExpression Throw(
+    const SourceSite& site, const char* message, int code) {
+    throw Exception(message, code, site);
+}
+
+template <typename Exception>
+[[noreturn]] CONTEXTUAL_EXCEPTION_COLD ThrowExpression Throw(
+    const SourceSite& site, const std::string& message, int code) {
+    throw Exception(message, code, site);
+}
+
+template <typename Exception, typename Source>
+[[noreturn]] CONTEXTUAL_EXCEPTION_COLD ThrowExpression ThrowWrap(
+    const SourceSite& site, const char* message, const Source& exception) {
+    throw Exception(message, exception, site);
+}
+
+template <typename Exception, typename Source>
+[[noreturn]] CONTEXTUAL_EXCEPTION_COLD ThrowExpression ThrowWrap(
+    const SourceSite& site, const std::string& message,
+    const Source& exception) {
+    throw Exception(message, exception, site);
+}
+
+template <typename Exception, typename Source>
+[[noreturn]] CONTEXTUAL_EXCEPTION_COLD ThrowExpression ThrowWrap(
+    const SourceSite& site, const char* message, int code,
+    const Source& exception) {
+    throw Exception(message, code, exception, site);
+}
+
+template <typename Exception, typename Source>
+[[noreturn]] CONTEXTUAL_EXCEPTION_COLD ThrowExpression ThrowWrap(
+    const SourceSite& site, const std::string& message, int code,
+    const Source& exception) {
+    throw Exception(message, code, exception, site);
+}
+
+template <typename Exception, int Placeholders, typename... Values>
+[[noreturn]] CONTEXTUAL_EXCEPTION_COLD ThrowExpression ThrowFormatted(
+    const SourceSite& site, int code, const char* format,
+    const Values&... values) {
+    static_assert(FormatArgumentsCheck<Placeholders, sizeof...(Values)>::value,
+                  "invalid format arguments");
+    throw Exception::MakeFormatted(site, code, format, values...);
+}
+
+// CONTEXTUAL_ENSURE 용: value 가 거짓이면 thrower(site) 호출, 아니면 value 반환
+// (rvalue 는 값으로, lvalue 는 참조로 반환)
+template <typename Value, typename Thrower>
+inline Value Ensure(Value&& value, const SourceSite& site,
+                    const Thrower& thrower) {
+    if (CONTEXTUAL_UNLIKELY(!value)) {
+        thrower(site);
+    }
+    return std::forward<Value>(value);
+}
+
 }  // namespace anonymous
 }  // namespace contextual_exception
 
+namespace contextual_exception {
+
+#if !defined(CONTEXTUAL_EXCEPTION_USE_FIXED_CAPACITY)
+// 매크로가 생성하는 예외 타입
+// (CONTEXTUAL_EXCEPTION_USE_FIXED_CAPACITY 정의 시 FixedContextualException)
+typedef ::ContextualException Exception;
+#endif
+
+}  // namespace contextual_exception
+
+// 매크로가 사용하는 생성 함수
+#if defined(CONTEXTUAL_EXCEPTION_USE_FIXED_CAPACITY)
+#define __CONTEXTUAL_MAKE                         \
+    ::contextual_exception::anonymous::MakeFixed< \
+        ::contextual_exception::Exception>
+#define __CONTEXTUAL_WRAP                         \
+    ::contextual_exception::anonymous::WrapFixed< \
+        ::contextual_exception::Exception>
+#define __CONTEXTUAL_MAKE_FORMATTED(placeholders)          \
+    ::contextual_exception::anonymous::MakeFixedFormatted< \
+        ::contextual_exception::Exception, placeholders>
+#else
+#define __CONTEXTUAL_MAKE ::contextual_exception::anonymous::Make
+#define __CONTEXTUAL_WRAP ::contextual_exception::anonymous::Wrap
+#define __CONTEXTUAL_MAKE_FORMATTED(placeholders) \
+    ::contextual_exception::anonymous::MakeFormatted<placeholders>
+#endif
+
 // 인자 개수 계산 매크로
 #define __CONTEXTUAL_GET_MACRO_ARGUMENTS_COUNT(_1, _2, _3, COUNT, ...) COUNT
 #define __CONTEXTUAL_EXPAND_MACRO(x) x
+// 첫 번째 인자 추출 매크로
+#define __CONTEXTUAL_FIRST_ARGUMENT(...) \
+    __CONTEXTUAL_EXPAND_MACRO(__CONTEXTUAL_FIRST_ARGUMENT_IMPL(__VA_ARGS__, _))
+#define __CONTEXTUAL_FIRST_ARGUMENT_IMPL(first, ...) first
 
 // usecase 1) CONTEXTUAL_EXCEPTION(message, code)
 // usecase 2) CONTEXTUAL_EXCEPTION(message)
-#define CONTEXTUAL_EXCEPTION(...)                                   \
-    ::contextual_exception::anonymous::Make(__FILENAME__, __LINE__, \
-                                            __FUNCTION__, __VA_ARGS__)
+#define CONTEXTUAL_EXCEPTION(...) \
+    __CONTEXTUAL_MAKE(*__CONTEXTUAL_FUNCTION_SOURCE_SITE(), __VA_ARGS__)
+
+// 형식 문자열 버전: 인자를 보관했다가 what() 등 최초 조회 시 포맷
+// - 형식 문자열은 리터럴이어야 하며 {} 개수와 인자 개수를 컴파일 시점에 검사
+// usecase) CONTEXTUAL_EXCEPTION_F("shard {} timeout after {}ms", id, ms)
+#define CONTEXTUAL_EXCEPTION_F(...) CONTEXTUAL_EXCEPTION_CODE_F(0, __VA_ARGS__)
+// usecase) CONTEXTUAL_EXCEPTION_CODE_F(code, "shard {} timeout", id)
+#define CONTEXTUAL_EXCEPTION_CODE_F(code, ...)                      \
+    __CONTEXTUAL_MAKE_FORMATTED(                                    \
+        ::contextual_exception::anonymous::CountFormatPlaceholders( \
+            __CONTEXTUAL_FIRST_ARGUMENT(__VA_ARGS__)))              \
+    (*__CONTEXTUAL_FUNCTION_SOURCE_SITE(), code, __VA_ARGS__)
+
+#define __CONTEXTUAL_CONCAT_IMPL(first, second) first##second
+#define __CONTEXTUAL_CONCAT(first, second) \
+    __CONTEXTUAL_CONCAT_IMPL(first, second)
+
+// 현재 범위가 끝날 때까지 이후 만들어지는 예외에 붙을 컨텍스트
+// - 형식 문자열은 리터럴, {} 개수와 인자 개수를 컴파일 시점에 검사
+// - lvalue 인자는 참조로 보관하므로 범위보다 오래 살아야 함
+// - ContextualException 에만 붙음 (FixedContextualException 제외)
+// - 코루틴에서는 co_await 를 사이에 두지 말 것 (ScopeContext 참고)
+// usecase) CONTEXTUAL_SCOPE("loading shard {}", shard_id);
+#define CONTEXTUAL_SCOPE(...)                                           \
+    auto&& __CONTEXTUAL_CONCAT(__contextual_scope_, __LINE__) =         \
+        ::contextual_exception::anonymous::MakeScope<                   \
+            ::contextual_exception::anonymous::CountFormatPlaceholders( \
+                __CONTEXTUAL_FIRST_ARGUMENT(__VA_ARGS__))>(             \
+            *__CONTEXTUAL_FUNCTION_SOURCE_SITE(), __VA_ARGS__)
 
 // usecase 1) WRAP_CONTEXTUAL_EXCEPTION(message, code, std::exception)
 // usecase 2) WRAP_CONTEXTUAL_EXCEPTION(message, std::exception)
-#define WRAP_CONTEXTUAL_EXCEPTION(...)                              \
-    ::contextual_exception::anonymous::Wrap(__FILENAME__, __LINE__, \
-                                            __FUNCTION__, __VA_ARGS__)
+#define WRAP_CONTEXTUAL_EXCEPTION(...) \
+    __CONTEXTUAL_WRAP(*__CONTEXTUAL_FUNCTION_SOURCE_SITE(), __VA_ARGS__)
 
 // usecase 1) SAFE_CHAIN_CONTEXTUAL_EXCEPTION(message, code, std::exception *)
 // usecase 2) SAFE_CHAIN_CONTEXTUAL_EXCEPTION(message, std::exception *)
-#define SAFE_CHAIN_CONTEXTUAL_EXCEPTION(...)                             \
-    ::contextual_exception::anonymous::SafeChain(__FILENAME__, __LINE__, \
-                                                 __FUNCTION__, __VA_ARGS__)
+#define SAFE_CHAIN_CONTEXTUAL_EXCEPTION(...)      \
+    ::contextual_exception::anonymous::SafeChain( \
+        *__CONTEXTUAL_FUNCTION_SOURCE_SITE(), __VA_ARGS__)
+
+// catch 한 예외에 컨텍스트를 추가한 뒤 throw; 로 원본 객체를 다시 던질 때 사용
+// usecase 1) ADD_CONTEXT_TO_CONTEXTUAL_EXCEPTION(exception, message, code)
+// usecase 2) ADD_CONTEXT_TO_CONTEXTUAL_EXCEPTION(exception, message)
+#define ADD_CONTEXT_TO_CONTEXTUAL_EXCEPTION(exception, ...) \
+    ::contextual_exception::anonymous::AddContext(          \
+        exception, *__CONTEXTUAL_FUNCTION_SOURCE_SITE(), __VA_ARGS__)
 
 // 내부 구현: 2개 인자 버전 (message, exception_ptr)
 #define __CHAIN_CONTEXTUAL_EXCEPTION_WITHOUT_CODE(message, exception_ptr) \
@@ -295,13 +2062,76 @@ inline ContextualException* SafeChain(
     __CONTEXTUAL_EXPAND_MACRO(                  \
         __CHOOSE_CHAIN_CONTEXTUAL_EXCEPTION_MACRO(__VA_ARGS__)(__VA_ARGS__))
 
+// THROW_* 매크로는 cold/noinline throw 함수를 호출
+// - 호출 지점에는 인자 전달과 call 만 남음
+// - 식의 타입은 ThrowExpression 이므로 throw 식과 같이 ?: 의 피연산자로 사용 가능
+// - throw 식과 달리 void 가 필요한 곳에는 사용 불가 (문장으로 쓸 것)
+//   return THROW_CONTEXTUAL_EXCEPTION("...");           // void 함수: 오류
+//   ok ? void() : THROW_CONTEXTUAL_EXCEPTION("...");     // 오류
+
 // usecase 1) THROW_CONTEXTUAL_EXCEPTION(message, code)
 // usecase 2) THROW_CONTEXTUAL_EXCEPTION(message)
-#define THROW_CONTEXTUAL_EXCEPTION(...) throw CONTEXTUAL_EXCEPTION(__VA_ARGS__)
+#define THROW_CONTEXTUAL_EXCEPTION(...)       \
+    ::contextual_exception::anonymous::Throw< \
+        ::contextual_exception::Exception>(   \
+        *__CONTEXTUAL_FUNCTION_SOURCE_SITE(), __VA_ARGS__)
+
+// usecase) THROW_CONTEXTUAL_EXCEPTION_F("shard {} timeout after {}ms", id, ms)
+#define THROW_CONTEXTUAL_EXCEPTION_F(...) \
+    THROW_CONTEXTUAL_EXCEPTION_CODE_F(0, __VA_ARGS__)
+// usecase) THROW_CONTEXTUAL_EXCEPTION_CODE_F(code, "shard {} timeout", id)
+#define THROW_CONTEXTUAL_EXCEPTION_CODE_F(code, ...)                \
+    ::contextual_exception::anonymous::ThrowFormatted<              \
+        ::contextual_exception::Exception,                          \
+        ::contextual_exception::anonymous::CountFormatPlaceholders( \
+            __CONTEXTUAL_FIRST_ARGUMENT(__VA_ARGS__))>(             \
+        *__CONTEXTUAL_FUNCTION_SOURCE_SITE(), code, __VA_ARGS__)
 
 // usecase 1) THROW_WRAP_CONTEXTUAL_EXCEPTION(message, code, std::exception)
 // usecase 2) THROW_WRAP_CONTEXTUAL_EXCEPTION(message, std::exception)
-#define THROW_WRAP_CONTEXTUAL_EXCEPTION(...) \
-    throw WRAP_CONTEXTUAL_EXCEPTION(__VA_ARGS__)
+#define THROW_WRAP_CONTEXTUAL_EXCEPTION(...)      \
+    ::contextual_exception::anonymous::ThrowWrap< \
+        ::contextual_exception::Exception>(       \
+        *__CONTEXTUAL_FUNCTION_SOURCE_SITE(), __VA_ARGS__)
+
+#if defined(CONTEXTUAL_EXCEPTION_USE_FIXED_CAPACITY)
+#include "FixedContextualException.hpp"
+#endif
+
+#if defined(CONTEXTUAL_EXCEPTION_FLIGHT_RECORDER)
+#include "ContextualFlightRecorder.hpp"
+#endif
+
+// 조건 검사 매크로
+// - 실패 분기는 unlikely 로 표시되고 cold throw 함수 호출만 포함
+// - 메시지 인자는 검사에 실패했을 때만 평가
+// - 메시지는 CONTEXTUAL_EXCEPTION_F 와 같은 형식 문자열 (리터럴)
+
+// usecase) CONTEXTUAL_CHECK(size <= limit, "size {} exceeds {}", size, limit);
+#define CONTEXTUAL_CHECK(condition, ...) \
+    CONTEXTUAL_CHECK_CODE(condition, 0, __VA_ARGS__)
+// usecase) CONTEXTUAL_CHECK_CODE(fd >= 0, EBADF, "invalid fd {}", fd);
+#define CONTEXTUAL_CHECK_CODE(condition, code, ...)               \
+    do {                                                          \
+        if (CONTEXTUAL_UNLIKELY(!(condition))) {                  \
+            THROW_CONTEXTUAL_EXCEPTION_CODE_F(code, __VA_ARGS__); \
+        }                                                         \
+    } while (0)
+
+// 값이 참(nullptr 아님 등)이면 그 값을 그대로 돌려주는 표현식 버전
+// usecase) auto* shard = CONTEXTUAL_ENSURE(FindShard(id), "no shard {}", id);
+#define CONTEXTUAL_ENSURE(value, ...) \
+    CONTEXTUAL_ENSURE_CODE(value, 0, __VA_ARGS__)
+// usecase) auto* shard = CONTEXTUAL_ENSURE_CODE(FindShard(id), 404, "none");
+#define CONTEXTUAL_ENSURE_CODE(value, code, ...)                            \
+    ::contextual_exception::anonymous::Ensure(                              \
+        value, *__CONTEXTUAL_FUNCTION_SOURCE_SITE(),                        \
+        [&](const ::contextual_exception::SourceSite& __contextual_site) {  \
+            ::contextual_exception::anonymous::ThrowFormatted<              \
+                ::contextual_exception::Exception,                          \
+                ::contextual_exception::anonymous::CountFormatPlaceholders( \
+                    __CONTEXTUAL_FIRST_ARGUMENT(__VA_ARGS__))>(             \
+                __contextual_site, code, __VA_ARGS__);                      \
+        })
 
 #endif  //__CONTEXTUAL_EXCEPTION_HPP__
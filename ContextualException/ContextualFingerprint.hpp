@@ -0,0 +1,268 @@
+#ifndef __CONTEXTUAL_FINGERPRINT_HPP__
+#define __CONTEXTUAL_FINGERPRINT_HPP__
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "ContextualException.hpp"
+
+// 프레임 체인 지문과 중복 집계
+// - 지문: 모든 프레임의 (file, line, function, code) 해시 (메시지는 무시)
+//   id 만 다른 같은 실패는 같은 지문
+// - 내용만으로 계산하므로 프로세스, 빌드, 플랫폼(엔디언)이 달라도 같은 값
+//   (std::throw_with_nested 로 중첩된 예외의 프레임 포함,
+//    FixedContextualException 이 생략한 프레임은 포함되지 않음)
+// usecase)
+//   static contextual_exception::ExceptionDeduplicator deduplicator;
+//   catch (const ContextualException& exception) {
+//       if (deduplicator.Add(exception)) {
+//           LOG(exception.DetailedErrorMessage());  // 처음 본 실패만
+//       }
+//   }
+//   ... (주기적으로)
+//   for (auto& group : deduplicator.Drain()) {
+//       // group.sample, group.count, group.first_time, group.last_time
+//   }
+
+namespace contextual_exception {
+namespace anonymous {
+
+// 64비트 곱셈-시프트 혼합 (비암호학적)
+inline std::uint64_t MixFingerprint(std::uint64_t hash, std::uint64_t value) {
+    hash = (hash ^ value) * 0x9e3779b97f4a7c15ULL;
+    return hash ^ (hash >> 29);
+}
+
+// 8바이트씩 리틀 엔디언으로 읽어 혼합 (길이 포함)
+inline std::uint64_t MixFingerprintText(std::uint64_t hash,
+                                        const char* text) {
+    std::size_t size = 0;
+    for (;;) {
+        std::uint64_t word = 0;
+        std::size_t ii = 0;
+        for (; ii < 8 && '\0' != text[ii]; ++ii) {
+            word |= static_cast<std::uint64_t>(
+                        static_cast<unsigned char>(text[ii]))
+                    << (8 * ii);
+        }
+        size += ii;
+        if (8 != ii) {
+            return MixFingerprint(MixFingerprint(hash, word), size);
+        }
+        hash = MixFingerprint(hash, word);
+        text += 8;
+    }
+}
+
+class FingerprintSink : public FrameSink {
+   public:
+    FingerprintSink() : hash_(0x6a09e667f3bcc908ULL) {}
+
+    virtual void AddFrame(const char* message, int code,
+                          const SourceSite& site) override {
+        (void)message;
+        AddSite(site, code);
+    }
+    virtual void AddFrames(const ::ContextualException& exception) override {
+        AddSite(*exception.BaseFrame().site, exception.BaseFrame().code);
+        for (const ::ContextualException::FrameNode* node =
+                 exception.ChildFrames();
+             node; node = node->next.get()) {
+            AddSite(*node->frame.site, node->frame.code);
+        }
+    }
+
+    std::uint64_t Fingerprint() const {
+        return hash_;
+    }
+
+   private:
+    void AddSite(const SourceSite& site, int code) {
+        hash_ = MixFingerprintText(hash_, site.file);
+        hash_ = MixFingerprintText(hash_, site.function);
+        const std::uint64_t line = static_cast<std::uint32_t>(site.line);
+        const std::uint64_t code_bits = static_cast<std::uint32_t>(code);
+        hash_ = MixFingerprint(hash_, (line << 32) | code_bits);
+    }
+
+    std::uint64_t hash_;
+};
+
+}  // namespace anonymous
+
+// exception 의 프레임 체인 지문
+inline std::uint64_t Fingerprint(const FrameSource& exception) {
+    anonymous::FingerprintSink sink;
+    anonymous::VisitSourceFrames(exception, &sink);
+    return sink.Fingerprint();
+}
+
+// 지문별 예외 집계 (스레드 안전, 락 없음)
+// - 지문당 첫 예외 하나(sample)와 횟수, 처음/마지막 시각만 보관
+// - 이미 본 지문은 슬롯 탐색 후 원자적 증가만 하므로 같은 실패가 여러
+//   스레드에서 몰려도 락 경합 없음 (처음 보는 지문만 sample 복사)
+// - 지문 종류가 max_groups 를 넘으면 새 지문은 OverflowCount() 로만 집계
+// - 그룹은 소멸 시까지 유지 (Drain 은 횟수, 시각만 초기화)
+class ExceptionDeduplicator {
+   public:
+    struct Group {
+        std::uint64_t fingerprint;
+        // 처음 추가된 예외 (ContextualException 이면 체인 공유)
+        ::ContextualException sample;
+        std::uint64_t count;
+        std::chrono::system_clock::time_point first_time;
+        std::chrono::system_clock::time_point last_time;
+    };
+
+    explicit ExceptionDeduplicator(std::size_t max_groups = 4096)
+        : max_groups_(max_groups),
+          capacity_(SlotCount(max_groups)),
+          slots_(new std::atomic<Node*>[capacity_]),
+          size_(0),
+          overflow_count_(0) {
+        for (std::size_t ii = 0; ii < capacity_; ++ii) {
+            slots_[ii].store(nullptr, std::memory_order_relaxed);
+        }
+    }
+    ExceptionDeduplicator(const ExceptionDeduplicator&) = delete;
+    ExceptionDeduplicator& operator=(const ExceptionDeduplicator&) = delete;
+    ~ExceptionDeduplicator() {
+        for (std::size_t ii = 0; ii < capacity_; ++ii) {
+            delete slots_[ii].load(std::memory_order_relaxed);
+        }
+    }
+
+    // 처음 보는 지문이면 true
+    bool Add(const FrameSource& exception) {
+        const std::uint64_t fingerprint = Fingerprint(exception);
+        const Clock::rep now = Clock::now().time_since_epoch().count();
+
+        for (std::size_t probe = 0; probe < capacity_; ++probe) {
+            std::atomic<Node*>& slot =
+                slots_[(fingerprint + probe) & (capacity_ - 1)];
+            Node* node = slot.load(std::memory_order_acquire);
+            if (!node) {
+                if (size_.load(std::memory_order_relaxed) >= max_groups_) {
+                    break;
+                }
+                Node* created = new Node(
+                    fingerprint, ::ContextualException::FromSource(exception),
+                    now);
+                if (slot.compare_exchange_strong(node, created,
+                                                 std::memory_order_acq_rel)) {
+                    size_.fetch_add(1, std::memory_order_relaxed);
+                    return true;
+                }
+                // 다른 스레드가 먼저 채움
+                delete created;
+            }
+            if (fingerprint == node->fingerprint) {
+                node->Add(now);
+                return false;
+            }
+        }
+        overflow_count_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    // 현재 집계 (횟수 내림차순)
+    // - 락 없이 읽으므로 동시에 진행 중인 Add 는 일부만 반영될 수 있음
+    std::vector<Group> Snapshot() const {
+        return Collect(false);
+    }
+
+    // 현재 집계를 넘기고 횟수, 시각을 비움 (주기적 보고용, 횟수 내림차순)
+    std::vector<Group> Drain() {
+        return Collect(true);
+    }
+
+    // max_groups 초과로 버린 예외 수
+    std::uint64_t OverflowCount() const {
+        return overflow_count_.load(std::memory_order_relaxed);
+    }
+
+   private:
+    typedef std::chrono::system_clock Clock;
+
+    struct Node {
+        const std::uint64_t fingerprint;
+        const ::ContextualException sample;
+        std::atomic<std::uint64_t> count;
+        // Clock 눈금 (0: Drain 이후 아직 없음)
+        std::atomic<Clock::rep> first_time;
+        std::atomic<Clock::rep> last_time;
+
+        Node(std::uint64_t fingerprint, ::ContextualException&& sample,
+             Clock::rep now)
+            : fingerprint(fingerprint),
+              sample(std::move(sample)),
+              count(1),
+              first_time(now),
+              last_time(now) {}
+
+        void Add(Clock::rep now) {
+            if (0 == count.fetch_add(1, std::memory_order_relaxed)) {
+                Clock::rep unset = 0;
+                first_time.compare_exchange_strong(unset, now,
+                                                   std::memory_order_relaxed);
+            }
+            last_time.store(now, std::memory_order_relaxed);
+        }
+    };
+
+    static std::size_t SlotCount(std::size_t max_groups) {
+        // 탐색이 짧도록 최대 그룹 수의 2배 이상인 2의 거듭제곱
+        std::size_t slots = 16;
+        while (slots < max_groups * 2) {
+            slots *= 2;
+        }
+        return slots;
+    }
+
+    std::vector<Group> Collect(bool drain) const {
+        std::vector<Group> groups;
+        for (std::size_t ii = 0; ii < capacity_; ++ii) {
+            Node* node = slots_[ii].load(std::memory_order_acquire);
+            if (!node) {
+                continue;
+            }
+            // 처음 시각을 먼저 비워야 그 사이 Add 가 다음 주기 값을 잃지 않음
+            const Clock::rep first_time =
+                drain ? node->first_time.exchange(0, std::memory_order_relaxed)
+                      : node->first_time.load(std::memory_order_relaxed);
+            const std::uint64_t count =
+                drain ? node->count.exchange(0, std::memory_order_relaxed)
+                      : node->count.load(std::memory_order_relaxed);
+            if (0 == count) {
+                continue;
+            }
+            const Clock::rep last_time =
+                node->last_time.load(std::memory_order_relaxed);
+            Group group = {node->fingerprint, node->sample, count,
+                           Clock::time_point(Clock::duration(first_time)),
+                           Clock::time_point(Clock::duration(last_time))};
+            groups.push_back(std::move(group));
+        }
+        std::sort(groups.begin(), groups.end(),
+                  [](const Group& left, const Group& right) {
+                      return left.count > right.count;
+                  });
+        return groups;
+    }
+
+    const std::size_t max_groups_;
+    const std::size_t capacity_;
+    const std::unique_ptr<std::atomic<Node*>[]> slots_;
+    std::atomic<std::size_t> size_;
+    std::atomic<std::uint64_t> overflow_count_;
+};
+
+}  // namespace contextual_exception
+
+#endif  //__CONTEXTUAL_FINGERPRINT_HPP__
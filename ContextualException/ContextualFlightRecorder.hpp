@@ -0,0 +1,375 @@
+#ifndef __CONTEXTUAL_FLIGHT_RECORDER_HPP__
+#define __CONTEXTUAL_FLIGHT_RECORDER_HPP__
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <thread>
+#include <vector>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <x86intrin.h>
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#endif
+
+#include "ContextualException.hpp"
+
+// 스레드별 최근 예외 기록 (CONTEXTUAL_EXCEPTION_FLIGHT_RECORDER)
+// - 예외가 생성될 때마다 (지점, 코드, 시각, 스레드) 를 스레드별 고정 크기 링에
+//   기록 (락, 할당 없음, 오래된 기록부터 덮어씀)
+// - 모든 예외를 로그로 남기지 않고 크래시 직전에 실패한 것들을 확인하는 용도
+// - 시각은 CPU 카운터(x86 TSC, AArch64 가상 카운터)로 기록하고 조회 시
+//   steady_clock 으로 환산 (그 외 환경은 steady_clock 직접 사용)
+// - 링은 스레드마다 1개 (스레드 종료 시 반환되어 다른 스레드가 재사용),
+//   동시에 CONTEXTUAL_EXCEPTION_FLIGHT_RECORDER_THREADS 개를 넘는 스레드는
+//   공유 링 1개에 기록 (여러 스레드가 같은 칸에 겹쳐 기록하면 한쪽은 버림)
+// - 모든 번역 단위에서 같게 정의할 것
+
+#ifndef CONTEXTUAL_EXCEPTION_FLIGHT_RECORDER_THREADS
+#define CONTEXTUAL_EXCEPTION_FLIGHT_RECORDER_THREADS 64
+#endif
+// 링당 기록 수 (2의 거듭제곱)
+#ifndef CONTEXTUAL_EXCEPTION_FLIGHT_RECORDER_ENTRIES
+#define CONTEXTUAL_EXCEPTION_FLIGHT_RECORDER_ENTRIES 256
+#endif
+
+namespace contextual_exception {
+
+// 조회된 기록 1건
+struct FlightRecord {
+    // 항상 유효 (정적 레코드 또는 InternSourceSite 레코드)
+    const SourceSite* site;
+    int code;
+    // std::hash<std::thread::id> 값
+    std::size_t thread;
+    std::chrono::steady_clock::time_point time;
+};
+
+class FlightRecorder {
+   public:
+    enum { kThreads = CONTEXTUAL_EXCEPTION_FLIGHT_RECORDER_THREADS };
+    enum { kEntries = CONTEXTUAL_EXCEPTION_FLIGHT_RECORDER_ENTRIES };
+    static_assert(kThreads >= 1, "at least one ring is required");
+    static_assert(kEntries >= 1 && 0 == (kEntries & (kEntries - 1)),
+                  "entries must be a power of two");
+
+    static void Record(const SourceSite& site,
+                       int code) CONTEXTUAL_EXCEPTION_NOEXCEPT {
+        ThreadState& state = CurrentThread();
+        if (CONTEXTUAL_UNLIKELY(!state.ring)) {
+            Claim(&state);
+        }
+        state.ring->Write(site, code, state.thread, state.shared);
+    }
+
+    // 모든 스레드의 기록을 오래된 순으로 병합해 하나씩 visitor 에 전달
+    // - visitor(const FlightRecord&)
+    // - 락, 할당 없음 (기록 중에도 호출 가능, 읽는 도중 덮어쓴 기록은 건너뜀)
+    // - 호출 이후에 추가된 기록은 포함하지 않음
+    template <typename Visitor>
+    static void Visit(Visitor&& visitor) {
+        Ring* rings = Rings();
+        const std::size_t ring_count = RingCount();
+
+        std::uint64_t cursors[kThreads + 1];
+        std::uint64_t ends[kThreads + 1];
+        Ring::Entry heads[kThreads + 1];
+        bool has_heads[kThreads + 1];
+        for (std::size_t ii = 0; ii < ring_count; ++ii) {
+            ends[ii] = rings[ii].Next();
+            cursors[ii] = ends[ii] > kEntries ? ends[ii] - kEntries : 0;
+            has_heads[ii] =
+                rings[ii].ReadNext(&cursors[ii], ends[ii], &heads[ii]);
+        }
+        const Clock clock = SampleClock();
+
+        for (;;) {
+            std::size_t oldest = ring_count;
+            for (std::size_t ii = 0; ii < ring_count; ++ii) {
+                if (has_heads[ii] &&
+                    (ring_count == oldest ||
+                     heads[ii].ticks < heads[oldest].ticks)) {
+                    oldest = ii;
+                }
+            }
+            if (ring_count == oldest) {
+                return;
+            }
+
+            const Ring::Entry& head = heads[oldest];
+            FlightRecord record;
+            record.site = head.site;
+            record.code = head.code;
+            record.thread = head.thread;
+            record.time = ToTimePoint(clock, head.ticks);
+            visitor(static_cast<const FlightRecord&>(record));
+
+            has_heads[oldest] = rings[oldest].ReadNext(
+                &cursors[oldest], ends[oldest], &heads[oldest]);
+        }
+    }
+
+    // Visit 결과를 모은 사본
+    static std::vector<FlightRecord> Snapshot() {
+        std::vector<FlightRecord> records;
+        Visit([&records](const FlightRecord& record) {
+            records.push_back(record);
+        });
+        return records;
+    }
+
+   private:
+    // 단일 기록자 링 (공유 링은 기록 위치를 원자적으로 할당)
+    // - 기록마다 시퀀스(위치 + 1)를 마지막에 게시하고, 읽는 쪽은 읽기 전후의
+    //   시퀀스가 같을 때만 사용 (seqlock)
+    // - 공유 링은 칸의 시퀀스를 kWriting 으로 바꾼 기록자만 기록하고,
+    //   이미 기록 중이거나 더 새 기록이 있는 칸이면 버림
+    class Ring {
+       public:
+        struct Entry {
+            const SourceSite* site;
+            int code;
+            std::size_t thread;
+            std::uint64_t ticks;
+        };
+
+        void Write(const SourceSite& site, int code, std::size_t thread,
+                   bool shared) CONTEXTUAL_EXCEPTION_NOEXCEPT {
+            std::uint64_t position;
+            if (CONTEXTUAL_LIKELY(!shared)) {
+                position = next_.load(std::memory_order_relaxed);
+                next_.store(position + 1, std::memory_order_release);
+            } else {
+                position = next_.fetch_add(1, std::memory_order_acq_rel);
+            }
+
+            Slot& slot = slots_[position & (kEntries - 1)];
+            if (CONTEXTUAL_LIKELY(!shared)) {
+                slot.sequence.store(kWriting, std::memory_order_relaxed);
+            } else {
+                std::uint64_t sequence =
+                    slot.sequence.load(std::memory_order_relaxed);
+                if (kWriting == sequence || sequence > position ||
+                    !slot.sequence.compare_exchange_strong(
+                        sequence, kWriting, std::memory_order_relaxed)) {
+                    return;
+                }
+            }
+            std::atomic_thread_fence(std::memory_order_release);
+            slot.site.store(&site, std::memory_order_relaxed);
+            slot.code.store(code, std::memory_order_relaxed);
+            slot.thread.store(thread, std::memory_order_relaxed);
+            slot.ticks.store(Ticks(), std::memory_order_relaxed);
+            slot.sequence.store(position + 1, std::memory_order_release);
+        }
+
+        // 스레드 전용으로 사용 (다른 스레드가 사용 중이면 false)
+        bool TryOwn() CONTEXTUAL_EXCEPTION_NOEXCEPT {
+            bool owned = false;
+            return owned_.compare_exchange_strong(owned, true,
+                                                  std::memory_order_acquire);
+        }
+        void Disown() CONTEXTUAL_EXCEPTION_NOEXCEPT {
+            owned_.store(false, std::memory_order_release);
+        }
+
+        std::uint64_t Next() const CONTEXTUAL_EXCEPTION_NOEXCEPT {
+            return next_.load(std::memory_order_acquire);
+        }
+
+        // [*cursor, end) 에서 온전한 첫 기록을 읽고 cursor 를 그 다음으로 이동
+        bool ReadNext(std::uint64_t* cursor, std::uint64_t end,
+                      Entry* entry) const CONTEXTUAL_EXCEPTION_NOEXCEPT {
+            while (*cursor < end) {
+                const std::uint64_t position = (*cursor)++;
+                const Slot& slot = slots_[position & (kEntries - 1)];
+                if (position + 1 !=
+                    slot.sequence.load(std::memory_order_acquire)) {
+                    continue;
+                }
+                entry->site = slot.site.load(std::memory_order_relaxed);
+                entry->code = slot.code.load(std::memory_order_relaxed);
+                entry->thread = slot.thread.load(std::memory_order_relaxed);
+                entry->ticks = slot.ticks.load(std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (position + 1 ==
+                    slot.sequence.load(std::memory_order_relaxed)) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+       private:
+        // 기록 중인 칸의 시퀀스 (0 은 빈 칸)
+        static const std::uint64_t kWriting = ~static_cast<std::uint64_t>(0);
+
+        struct Slot {
+            std::atomic<std::uint64_t> sequence;
+            std::atomic<const SourceSite*> site;
+            std::atomic<int> code;
+            std::atomic<std::size_t> thread;
+            std::atomic<std::uint64_t> ticks;
+        };
+
+        std::atomic<std::uint64_t> next_;
+        std::atomic<bool> owned_;
+        Slot slots_[kEntries];
+    };
+
+    struct ThreadState {
+        Ring* ring;
+        std::size_t thread;
+        bool shared;
+    };
+
+    // 스레드 종료 시 링 반환 (Claim 에서만 생성하므로 Record 는 그대로
+    // 초기화 검사 없는 스레드 저장소만 사용)
+    // - 이후 다른 thread_local 소멸자에서 생성된 예외는 공유 링에 기록
+    struct RingRelease {
+        ThreadState* state;
+
+        ~RingRelease() {
+            Ring* ring = state->ring;
+            state->ring = &Rings()[kThreads];
+            state->shared = true;
+            ring->Disown();
+        }
+    };
+
+    // 틱과 steady_clock 의 대응 (틱 -> 시각 환산용)
+    struct Clock {
+        std::uint64_t ticks;
+        std::int64_t nanoseconds;
+        double nanoseconds_per_tick;
+    };
+
+    static std::uint64_t Ticks() CONTEXTUAL_EXCEPTION_NOEXCEPT {
+#if (defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))) || \
+    (defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86)))
+        return __rdtsc();
+#elif defined(__GNUC__) && defined(__aarch64__)
+        std::uint64_t ticks;
+        __asm__ __volatile__("mrs %0, cntvct_el0" : "=r"(ticks));
+        return ticks;
+#else
+        return static_cast<std::uint64_t>(SteadyNanoseconds());
+#endif
+    }
+
+    static std::int64_t SteadyNanoseconds() CONTEXTUAL_EXCEPTION_NOEXCEPT {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   std::chrono::steady_clock::now().time_since_epoch())
+            .count();
+    }
+
+    // 최초 링 할당 시 기록한 기준점과 현재 시점으로 틱 간격 계산
+    static Clock SampleClock() CONTEXTUAL_EXCEPTION_NOEXCEPT {
+        Clock clock;
+        clock.ticks = Ticks();
+        clock.nanoseconds = SteadyNanoseconds();
+        clock.nanoseconds_per_tick = 1.0;
+
+        const Anchor& anchor = GetAnchor();
+        if (kAnchorReady == anchor.state.load(std::memory_order_acquire) &&
+            clock.ticks > anchor.ticks) {
+            clock.nanoseconds_per_tick =
+                static_cast<double>(clock.nanoseconds - anchor.nanoseconds) /
+                static_cast<double>(clock.ticks - anchor.ticks);
+        }
+        return clock;
+    }
+
+    static std::chrono::steady_clock::time_point ToTimePoint(
+        const Clock& clock, std::uint64_t ticks) CONTEXTUAL_EXCEPTION_NOEXCEPT {
+        // 조회 시작 이후의 기록은 음수 간격
+        const std::int64_t elapsed_ticks =
+            static_cast<std::int64_t>(clock.ticks - ticks);
+        const double elapsed =
+            static_cast<double>(elapsed_ticks) * clock.nanoseconds_per_tick;
+        return std::chrono::steady_clock::time_point(
+            std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                std::chrono::nanoseconds(
+                    clock.nanoseconds - static_cast<std::int64_t>(elapsed))));
+    }
+
+    enum { kAnchorEmpty = 0, kAnchorWriting = 1, kAnchorReady = 2 };
+    struct Anchor {
+        std::atomic<int> state;
+        std::uint64_t ticks;
+        std::int64_t nanoseconds;
+    };
+    static Anchor& GetAnchor() CONTEXTUAL_EXCEPTION_NOEXCEPT {
+        static Anchor anchor;
+        return anchor;
+    }
+
+    // 상수 초기화되는 정적/스레드 저장소 (초기화 검사, 소멸자 등록 없음)
+    static Ring* Rings() CONTEXTUAL_EXCEPTION_NOEXCEPT {
+        static Ring rings[kThreads + 1];
+        return rings;
+    }
+    // 한 번이라도 사용된 링의 최대 인덱스 + 1 (공유 링 포함)
+    static std::atomic<std::size_t>& UsedRings() CONTEXTUAL_EXCEPTION_NOEXCEPT {
+        static std::atomic<std::size_t> used_rings;
+        return used_rings;
+    }
+    static std::size_t RingCount() CONTEXTUAL_EXCEPTION_NOEXCEPT {
+        return UsedRings().load(std::memory_order_acquire);
+    }
+    static ThreadState& CurrentThread() CONTEXTUAL_EXCEPTION_NOEXCEPT {
+        static thread_local ThreadState state;
+        return state;
+    }
+
+    CONTEXTUAL_EXCEPTION_COLD static void Claim(ThreadState* state)
+        CONTEXTUAL_EXCEPTION_NOEXCEPT {
+        Anchor& anchor = GetAnchor();
+        int expected = kAnchorEmpty;
+        if (anchor.state.compare_exchange_strong(expected, kAnchorWriting,
+                                                 std::memory_order_acquire)) {
+            anchor.ticks = Ticks();
+            anchor.nanoseconds = SteadyNanoseconds();
+            anchor.state.store(kAnchorReady, std::memory_order_release);
+        }
+
+        // 비어 있는 링 중 가장 앞의 것 (없으면 공유 링)
+        Ring* rings = Rings();
+        const std::size_t shared_ring = kThreads;
+        std::size_t index = 0;
+        while (index < shared_ring && !rings[index].TryOwn()) {
+            ++index;
+        }
+        state->shared = index >= shared_ring;
+        state->ring = &rings[index];
+        state->thread =
+            std::hash<std::thread::id>()(std::this_thread::get_id());
+
+        std::atomic<std::size_t>& used_rings = UsedRings();
+        std::size_t used = used_rings.load(std::memory_order_relaxed);
+        while (used <= index &&
+               !used_rings.compare_exchange_weak(used, index + 1,
+                                                 std::memory_order_acq_rel)) {
+        }
+
+        if (!state->shared) {
+            static thread_local RingRelease release;
+            release.state = state;
+        }
+    }
+};
+
+namespace anonymous {
+
+inline void RecordFlight(const SourceSite& site,
+                         int code) CONTEXTUAL_EXCEPTION_NOEXCEPT {
+    FlightRecorder::Record(site, code);
+}
+
+}  // namespace anonymous
+}  // namespace contextual_exception
+
+#endif  //__CONTEXTUAL_FLIGHT_RECORDER_HPP__
@@ -0,0 +1,161 @@
+#ifndef __CONTEXTUAL_HOP_HPP__
+#define __CONTEXTUAL_HOP_HPP__
+
+#include <chrono>
+#include <exception>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+#include "ContextualException.hpp"
+
+// 스레드 경계를 넘은 예외에 hop 프레임 추가
+// - hop 프레임: 실행기 이름, 실행 스레드, 큐 대기 시간, 실행 시간
+//   "hop executor=io thread=140213 queued=1520us ran=35us"
+// - AddContext 와 같이 기본 프레임으로 추가하고 기존 체인은 공유 (O(1))
+// - code 는 원래 기본 프레임의 code 를 유지
+// - 메시지는 지연 포맷 (what() 등 최초 조회 시 렌더링)
+// - 대상은 ContextualException 과 매크로가 생성하는 예외 타입
+//   (CONTEXTUAL_EXCEPTION_USE_FIXED_CAPACITY 이면 FixedContextualException,
+//    이때 메시지는 추가 시점에 프레임 버퍼로 포맷)
+// usecase 1) 작업을 감싸 실행 스레드에서 추가 (future.get() 이 그대로 전달)
+//   auto future = std::async(
+//       std::launch::async, CONTEXTUAL_HOP_TASK("io", [&] { return Load(); }));
+// usecase 2) exception_ptr 을 직접 전달하는 실행기
+//   auto hop = contextual_exception::TaskHop::Enqueue("io");  // 제출 시
+//   hop.Dequeue();                                            // 실행 시작 시
+//   CONTEXTUAL_RETHROW_WITH_HOP(exception_ptr, hop);          // 호출자에서
+
+namespace contextual_exception {
+
+// 작업이 실행기를 거친 기록
+struct TaskHop {
+    // 리터럴 또는 hop 프레임 추가 시점까지 유효한 문자열
+    const char* executor;
+    std::chrono::steady_clock::time_point enqueue_time;
+    std::chrono::steady_clock::time_point dequeue_time;
+    std::thread::id thread;
+
+    // 작업 제출 시점
+    static TaskHop Enqueue(const char* executor) {
+        const std::chrono::steady_clock::time_point now =
+            std::chrono::steady_clock::now();
+        TaskHop hop = {executor, now, now, std::thread::id()};
+        return hop;
+    }
+    // 실행 스레드에서 작업 시작 시점
+    void Dequeue() {
+        dequeue_time = std::chrono::steady_clock::now();
+        thread = std::this_thread::get_id();
+    }
+};
+
+// exception 에 hop 프레임 추가 (실행 시간은 지금까지)
+// (ContextualException, FixedContextualException)
+template <typename Exception>
+inline void AddHop(Exception& exception, const TaskHop& hop,
+                   const SourceSite& site) {
+    typedef std::chrono::microseconds Microseconds;
+    const std::chrono::steady_clock::time_point now =
+        std::chrono::steady_clock::now();
+    const long long queued = static_cast<long long>(
+        std::chrono::duration_cast<Microseconds>(hop.dequeue_time -
+                                                 hop.enqueue_time)
+            .count());
+    const long long ran = static_cast<long long>(
+        std::chrono::duration_cast<Microseconds>(now - hop.dequeue_time)
+            .count());
+    exception.AddFormattedContext(
+        site, exception.Code(),
+        "hop executor={} thread={} queued={}us ran={}us", hop.executor,
+        hop.thread, queued, ran);
+}
+
+// exception 을 다시 던지며 ContextualException 등이면 hop 프레임 추가
+// - exception_ptr 이 가리키는 객체는 바꾸지 않고 복사본(체인 공유)에 추가
+//   (shared_future 등으로 여러 곳에서 다시 던져도 hop 이 중복되지 않음)
+// - 그 외 예외는 그대로 다시 던짐
+[[noreturn]] inline void RethrowWithHop(const std::exception_ptr& exception,
+                                        const TaskHop& hop,
+                                        const SourceSite& site) {
+    try {
+        std::rethrow_exception(exception);
+    } catch (const ::ContextualException& thrown) {
+        ::ContextualException copy(thrown);
+        AddHop(copy, hop, site);
+        throw copy;
+    }
+#if defined(CONTEXTUAL_EXCEPTION_USE_FIXED_CAPACITY)
+    catch (const Exception& thrown) {
+        Exception copy(thrown);
+        AddHop(copy, hop, site);
+        throw copy;
+    }
+#endif
+}
+
+// 호출 시 Dequeue 하고, ContextualException 등이 나오면 hop 프레임을 추가한
+// 복사본(체인 공유)을 던지는 작업 (std::async, packaged_task, 스레드 풀 등에
+// 전달)
+// - 작업이 shared_future::get() 등으로 다시 던진 객체는 여러 곳에서 공유될
+//   수 있으므로 바꾸지 않음
+template <typename Function>
+class HopTask {
+   public:
+    HopTask(const SourceSite& site, const char* executor, Function function)
+        : site_(&site),
+          hop_(TaskHop::Enqueue(executor)),
+          function_(std::move(function)) {}
+
+    template <typename... Arguments>
+    auto operator()(Arguments&&... arguments)
+        -> decltype(std::declval<Function&>()(
+            std::forward<Arguments>(arguments)...)) {
+        hop_.Dequeue();
+        try {
+            return function_(std::forward<Arguments>(arguments)...);
+        } catch (const ::ContextualException& exception) {
+            ThrowWithHop(exception);
+        }
+#if defined(CONTEXTUAL_EXCEPTION_USE_FIXED_CAPACITY)
+        catch (const Exception& exception) {
+            ThrowWithHop(exception);
+        }
+#endif
+    }
+
+   private:
+    template <typename Exception>
+    [[noreturn]] CONTEXTUAL_EXCEPTION_COLD void ThrowWithHop(
+        const Exception& exception) const {
+        Exception copy(exception);
+        AddHop(copy, hop_, *site_);
+        throw copy;
+    }
+
+    const SourceSite* site_;
+    TaskHop hop_;
+    Function function_;
+};
+
+template <typename Function>
+inline HopTask<typename std::decay<Function>::type> MakeHopTask(
+    const SourceSite& site, const char* executor, Function&& function) {
+    return HopTask<typename std::decay<Function>::type>(
+        site, executor, std::forward<Function>(function));
+}
+
+}  // namespace contextual_exception
+
+// 제출 시점에 대기 시간 측정을 시작하는 작업 (hop 프레임 위치는 제출 지점)
+// usecase) pool.Submit(CONTEXTUAL_HOP_TASK("io", [&] { Load(shard); }));
+#define CONTEXTUAL_HOP_TASK(executor, ...)                                    \
+    ::contextual_exception::MakeHopTask(*__CONTEXTUAL_FUNCTION_SOURCE_SITE(), \
+                                        executor, __VA_ARGS__)
+
+// usecase) CONTEXTUAL_RETHROW_WITH_HOP(task.exception, task.hop);
+#define CONTEXTUAL_RETHROW_WITH_HOP(exception_ptr, hop)        \
+    ::contextual_exception::RethrowWithHop(exception_ptr, hop, \
+                                           *__CONTEXTUAL_FUNCTION_SOURCE_SITE())
+
+#endif  //__CONTEXTUAL_HOP_HPP__
@@ -0,0 +1,228 @@
+#ifndef __CONTEXTUAL_RATE_LIMITER_HPP__
+#define __CONTEXTUAL_RATE_LIMITER_HPP__
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "ContextualException.hpp"
+
+// 호출 지점(또는 코드)별 토큰 버킷으로 예외 기록 여부 결정
+// - 판단은 락 없이 O(1): 키 슬롯 탐색 + CAS 1회 (GCRA 방식 토큰 버킷)
+// - 선택된 예외만 DetailedErrorMessage() 로 렌더링
+// - 억제된 수는 키별로 모아 ReportSuppressed 로 주기적으로 요약
+// usecase)
+//   static contextual_exception::ExceptionReporter reporter(10, 20);
+//   catch (const ContextualException& exception) {
+//       reporter.Report(exception, [](const std::string& text) {
+//           LOG(text);
+//       });
+//   }
+//   ... (주기적으로)
+//   reporter.ReportSuppressed([](const std::string& text) { LOG(text); });
+//   // "a.cpp:10 | Run() | 1234 suppressed"
+
+namespace contextual_exception {
+
+class ExceptionReporter {
+   public:
+    enum Key {
+        kPerSite,  // 기본 프레임의 호출 지점
+        kPerCode   // 기본 프레임의 code
+    };
+
+    // 키마다 초당 reports_per_second 개, 순간 최대 burst 개까지 선택
+    // - 키 종류가 max_keys 를 넘으면 나머지 키는 버킷 하나를 공유
+    // - 토큰 간격은 최대 약 52일 (reports_per_second 가 0 이하이거나 NaN 이면
+    //   이 간격이므로 키마다 사실상 처음 burst 개만 선택)
+    // - burst 가 1 미만(NaN 포함)이면 1
+    ExceptionReporter(double reports_per_second, double burst,
+                      Key key = kPerSite, std::size_t max_keys = 1024)
+        : key_(key),
+          interval_(ClampNanoseconds(1e9 / reports_per_second, kMaxInterval)),
+          tolerance_(ClampNanoseconds(
+              (burst >= 1 ? burst - 1 : 0) * static_cast<double>(interval_),
+              kMaxTolerance)),
+          max_keys_(max_keys),
+          capacity_(SlotCount(max_keys)),
+          slots_(new Slot[capacity_]),
+          keys_(0) {}
+    ExceptionReporter(const ExceptionReporter&) = delete;
+    ExceptionReporter& operator=(const ExceptionReporter&) = delete;
+
+    // 기록할 차례이면 true, 아니면 억제 수에 더함
+    bool ShouldReport(const SourceSite& site, int code) {
+        Slot& slot = FindSlot(KeyOf(site, code));
+        if (Take(&slot.theoretical_arrival)) {
+            return true;
+        }
+        slot.suppressed.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    // ContextualException, FixedContextualException
+    template <typename Exception>
+    bool ShouldReport(const Exception& exception) {
+        return ShouldReport(*exception.BaseFrame().site, exception.Code());
+    }
+
+    // 선택된 예외만 렌더링해 log(const std::string&) 호출
+    template <typename Exception, typename Log>
+    bool Report(const Exception& exception, const Log& log) {
+        if (!ShouldReport(exception)) {
+            return false;
+        }
+        log(exception.DetailedErrorMessage());
+        return true;
+    }
+
+    // 지난 호출 이후 억제된 수를 키마다 한 줄로 log(const std::string&)
+    // 에 넘기고 비움
+    template <typename Log>
+    void ReportSuppressed(const Log& log) {
+        for (std::size_t ii = 0; ii <= capacity_; ++ii) {
+            Slot& slot = ii < capacity_ ? slots_[ii] : shared_slot_;
+            const std::uint64_t suppressed =
+                slot.suppressed.exchange(0, std::memory_order_relaxed);
+            if (0 == suppressed) {
+                continue;
+            }
+            std::string text;
+            auto append = [&text](const char* data, std::size_t size) {
+                text.append(data, size);
+            };
+            anonymous::AppendWriter<decltype(append)> writer(append);
+            const std::uint64_t key = slot.key.load(std::memory_order_relaxed);
+            if (ii == capacity_) {
+                writer.Append("(other keys) ");
+            } else if (kPerSite == key_) {
+                const SourceSite& site =
+                    *reinterpret_cast<const SourceSite*>(key);
+                const int default_code = 0;
+                anonymous::WriteFrameText(&writer, site, default_code, "");
+            } else {
+                writer.Append("[code=");
+                writer.AppendInteger(static_cast<int>(key));
+                writer.Append("] ");
+            }
+            writer.AppendInteger(static_cast<long long>(suppressed));
+            writer.Append(" suppressed");
+            log(text);
+        }
+    }
+
+   private:
+    struct Slot {
+        // 0: 비어 있음 (kPerSite: SourceSite 주소, kPerCode: 1<<32 | code)
+        std::atomic<std::uint64_t> key;
+        // 다음 토큰이 생기는 시각 (steady_clock 나노초)
+        std::atomic<std::int64_t> theoretical_arrival;
+        std::atomic<std::uint64_t> suppressed;
+
+        Slot() : key(0), theoretical_arrival(0), suppressed(0) {}
+    };
+
+    // 토큰 간격 상한 (약 52일)
+    static const std::int64_t kMaxInterval = INT64_C(1) << 52;
+    // 허용 범위 상한 (시각에 간격과 함께 더해도 넘치지 않는 값)
+    static const std::int64_t kMaxTolerance = INT64_C(1) << 62;
+    // 키마다 탐색하는 최대 슬롯 수 (넘으면 공유 슬롯)
+    enum { kMaxProbes = 32 };
+
+    // 0 이상 limit 이하로 (비율이 0 이하이면 음수, 무한대, NaN 이므로 상한)
+    static std::int64_t ClampNanoseconds(double nanoseconds,
+                                         std::int64_t limit) {
+        if (!(nanoseconds >= 0) ||
+            !(nanoseconds < static_cast<double>(limit))) {
+            return limit;
+        }
+        return static_cast<std::int64_t>(nanoseconds);
+    }
+
+    static std::size_t SlotCount(std::size_t max_keys) {
+        // 탐색이 짧도록 최대 키 수의 2배 이상인 2의 거듭제곱
+        std::size_t slots = 16;
+        while (slots < max_keys * 2) {
+            slots *= 2;
+        }
+        return slots;
+    }
+
+    std::uint64_t KeyOf(const SourceSite& site, int code) const {
+        if (kPerSite == key_) {
+            return reinterpret_cast<std::uintptr_t>(&site);
+        }
+        return (static_cast<std::uint64_t>(1) << 32) |
+               static_cast<std::uint32_t>(code);
+    }
+
+    // 키 수가 max_keys 에 이르렀거나 kMaxProbes 안에 자리가 없으면 공유 슬롯
+    Slot& FindSlot(std::uint64_t key) {
+        const std::size_t start = static_cast<std::size_t>(
+            (key * 0x9e3779b97f4a7c15ULL) >> 32);
+        std::size_t probes = kMaxProbes;
+        if (capacity_ < probes) {
+            probes = capacity_;
+        }
+        for (std::size_t probe = 0; probe < probes; ++probe) {
+            Slot& slot = slots_[(start + probe) & (capacity_ - 1)];
+            std::uint64_t current = slot.key.load(std::memory_order_relaxed);
+            if (CONTEXTUAL_LIKELY(key == current)) {
+                return slot;
+            }
+            if (0 != current) {
+                continue;
+            }
+            // 빈 슬롯: 키 수를 먼저 예약하고 차지 (실패하면 예약 취소)
+            if (keys_.fetch_add(1, std::memory_order_relaxed) >= max_keys_) {
+                keys_.fetch_sub(1, std::memory_order_relaxed);
+                return shared_slot_;
+            }
+            if (slot.key.compare_exchange_strong(current, key,
+                                                 std::memory_order_relaxed)) {
+                return slot;
+            }
+            keys_.fetch_sub(1, std::memory_order_relaxed);
+            if (key == current) {
+                return slot;
+            }
+        }
+        return shared_slot_;
+    }
+
+    // 토큰 1개 소모 (GCRA: 다음 토큰 시각이 허용 범위 안이면 통과)
+    bool Take(std::atomic<std::int64_t>* theoretical_arrival) const {
+        const std::int64_t now =
+            std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch())
+                .count();
+        std::int64_t current =
+            theoretical_arrival->load(std::memory_order_relaxed);
+        for (;;) {
+            const std::int64_t start = current > now ? current : now;
+            if (start - now > tolerance_) {
+                return false;
+            }
+            if (theoretical_arrival->compare_exchange_weak(
+                    current, start + interval_, std::memory_order_relaxed)) {
+                return true;
+            }
+        }
+    }
+
+    const Key key_;
+    const std::int64_t interval_;
+    const std::int64_t tolerance_;
+    const std::size_t max_keys_;
+    const std::size_t capacity_;
+    const std::unique_ptr<Slot[]> slots_;
+    Slot shared_slot_;
+    // 차지된 슬롯 수 (max_keys_ 이하)
+    std::atomic<std::size_t> keys_;
+};
+
+}  // namespace contextual_exception
+
+#endif  //__CONTEXTUAL_RATE_LIMITER_HPP__
@@ -0,0 +1,400 @@
+#ifndef __CONTEXTUAL_RESULT_HPP__
+#define __CONTEXTUAL_RESULT_HPP__
+
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#if defined(__has_include)
+#if __has_include(<expected>) && \
+    (__cplusplus > 202002L || (defined(_MSVC_LANG) && _MSVC_LANG > 202002L))
+#include <expected>
+#endif
+#endif
+
+#include "ContextualException.hpp"
+
+// 예외를 던지지 않는 오류 전파
+// - 실패가 잦은 경로(캐시 미스, 파서 거부 등)에서 throw/catch 대신 사용
+// - 오류 쪽은 ContextualException 프레임 체인
+//   (CONTEXTUAL_EXCEPTION_USE_FIXED_CAPACITY 와 무관하게 항상 ContextualException,
+//    ValueOrThrow 는 매크로가 생성하는 예외 타입으로 throw)
+// - 실패 분기에 unlikely 힌트를 두지 않음 (실패가 흔한 경로용)
+
+namespace contextual_exception {
+
+#if defined(__cpp_lib_expected)
+
+// C++23: std::expected<Value, ContextualException>
+template <typename Value>
+using Result = std::expected<Value, ::ContextualException>;
+typedef std::unexpected<::ContextualException> Unexpected;
+
+#else
+
+// std::expected 가 없는 환경용 최소 구현 (std::expected 의 부분 집합)
+// - value() 는 제공하지 않음 (ValueOrThrow 사용)
+class Unexpected {
+   public:
+    explicit Unexpected(::ContextualException error)
+        : error_(std::move(error)) {}
+
+    ::ContextualException& error() & {
+        return error_;
+    }
+    const ::ContextualException& error() const& {
+        return error_;
+    }
+    ::ContextualException&& error() && {
+        return std::move(error_);
+    }
+
+   private:
+    ::ContextualException error_;
+};
+
+template <typename Value>
+class Result {
+   public:
+    typedef Value value_type;
+    typedef ::ContextualException error_type;
+
+   public:
+    Result() : has_value_(true) {
+        new (&value_) Value();
+    }
+    template <typename Other = Value,
+              typename = typename std::enable_if<
+                  std::is_constructible<Value, Other&&>::value &&
+                  !std::is_same<typename std::decay<Other>::type,
+                                Result>::value &&
+                  !std::is_same<typename std::decay<Other>::type,
+                                Unexpected>::value>::type>
+    Result(Other&& value) : has_value_(true) {
+        new (&value_) Value(std::forward<Other>(value));
+    }
+    Result(const Unexpected& unexpected) : has_value_(false) {
+        new (&error_) error_type(unexpected.error());
+    }
+    Result(Unexpected&& unexpected) : has_value_(false) {
+        new (&error_) error_type(std::move(unexpected).error());
+    }
+
+    Result(const Result& other) : has_value_(other.has_value_) {
+        if (has_value_) {
+            new (&value_) Value(other.value_);
+        } else {
+            new (&error_) error_type(other.error_);
+        }
+    }
+    Result(Result&& other) CONTEXTUAL_EXCEPTION_NOEXCEPT_IF(
+        std::is_nothrow_move_constructible<Value>::value &&
+        std::is_nothrow_move_constructible<error_type>::value)
+        : has_value_(other.has_value_) {
+        if (has_value_) {
+            new (&value_) Value(std::move(other.value_));
+        } else {
+            new (&error_) error_type(std::move(other.error_));
+        }
+    }
+
+    Result& operator=(const Result& other) {
+        if (this != &other) {
+            Result copy(other);
+            *this = std::move(copy);
+        }
+        return *this;
+    }
+    Result& operator=(Result&& other) CONTEXTUAL_EXCEPTION_NOEXCEPT_IF(
+        std::is_nothrow_move_constructible<Value>::value &&
+        std::is_nothrow_move_assignable<Value>::value &&
+        std::is_nothrow_move_constructible<error_type>::value &&
+        std::is_nothrow_move_assignable<error_type>::value) {
+        if (this == &other) {
+            return *this;
+        }
+        if (has_value_ && other.has_value_) {
+            value_ = std::move(other.value_);
+        } else if (!has_value_ && !other.has_value_) {
+            error_ = std::move(other.error_);
+        } else {
+            Destroy();
+            has_value_ = other.has_value_;
+            if (has_value_) {
+                new (&value_) Value(std::move(other.value_));
+            } else {
+                new (&error_) error_type(std::move(other.error_));
+            }
+        }
+        return *this;
+    }
+
+    ~Result() {
+        Destroy();
+    }
+
+   public:
+    bool has_value() const CONTEXTUAL_EXCEPTION_NOEXCEPT {
+        return has_value_;
+    }
+    explicit operator bool() const CONTEXTUAL_EXCEPTION_NOEXCEPT {
+        return has_value_;
+    }
+
+    // has_value() 일 때만 호출
+    Value& operator*() & {
+        return value_;
+    }
+    const Value& operator*() const& {
+        return value_;
+    }
+    Value&& operator*() && {
+        return std::move(value_);
+    }
+    Value* operator->() {
+        return &value_;
+    }
+    const Value* operator->() const {
+        return &value_;
+    }
+
+    template <typename Other>
+    Value value_or(Other&& other) const& {
+        return has_value_ ? value_
+                          : static_cast<Value>(std::forward<Other>(other));
+    }
+    template <typename Other>
+    Value value_or(Other&& other) && {
+        return has_value_ ? std::move(value_)
+                          : static_cast<Value>(std::forward<Other>(other));
+    }
+
+    // !has_value() 일 때만 호출
+    error_type& error() & {
+        return error_;
+    }
+    const error_type& error() const& {
+        return error_;
+    }
+    error_type&& error() && {
+        return std::move(error_);
+    }
+
+   private:
+    void Destroy() {
+        if (has_value_) {
+            value_.~Value();
+        } else {
+            error_.~error_type();
+        }
+    }
+
+   private:
+    union {
+        Value value_;
+        error_type error_;
+    };
+    bool has_value_;
+};
+
+template <>
+class Result<void> {
+   public:
+    typedef void value_type;
+    typedef ::ContextualException error_type;
+
+   public:
+    Result() : has_value_(true) {}
+    Result(const Unexpected& unexpected) : has_value_(false) {
+        new (&error_) error_type(unexpected.error());
+    }
+    Result(Unexpected&& unexpected) : has_value_(false) {
+        new (&error_) error_type(std::move(unexpected).error());
+    }
+
+    Result(const Result& other) : has_value_(other.has_value_) {
+        if (!has_value_) {
+            new (&error_) error_type(other.error_);
+        }
+    }
+    Result(Result&& other) CONTEXTUAL_EXCEPTION_NOEXCEPT_IF(
+        std::is_nothrow_move_constructible<error_type>::value)
+        : has_value_(other.has_value_) {
+        if (!has_value_) {
+            new (&error_) error_type(std::move(other.error_));
+        }
+    }
+
+    Result& operator=(const Result& other) {
+        if (this != &other) {
+            Result copy(other);
+            *this = std::move(copy);
+        }
+        return *this;
+    }
+    Result& operator=(Result&& other) CONTEXTUAL_EXCEPTION_NOEXCEPT_IF(
+        std::is_nothrow_move_constructible<error_type>::value) {
+        if (this != &other) {
+            Destroy();
+            has_value_ = other.has_value_;
+            if (!has_value_) {
+                new (&error_) error_type(std::move(other.error_));
+            }
+        }
+        return *this;
+    }
+
+    ~Result() {
+        Destroy();
+    }
+
+   public:
+    bool has_value() const CONTEXTUAL_EXCEPTION_NOEXCEPT {
+        return has_value_;
+    }
+    explicit operator bool() const CONTEXTUAL_EXCEPTION_NOEXCEPT {
+        return has_value_;
+    }
+    void operator*() const {}
+
+    // !has_value() 일 때만 호출
+    error_type& error() & {
+        return error_;
+    }
+    const error_type& error() const& {
+        return error_;
+    }
+    error_type&& error() && {
+        return std::move(error_);
+    }
+
+   private:
+    void Destroy() {
+        if (!has_value_) {
+            error_.~error_type();
+        }
+    }
+
+   private:
+    union {
+        error_type error_;
+    };
+    bool has_value_;
+};
+
+#endif
+
+namespace anonymous {
+
+// 오류를 매크로가 생성하는 예외 타입으로 throw
+// (FixedContextualException 이면 프레임을 옮겨 담음)
+template <typename Error>
+[[noreturn]] CONTEXTUAL_EXCEPTION_COLD void ThrowError(Error&& error) {
+#if defined(CONTEXTUAL_EXCEPTION_USE_FIXED_CAPACITY)
+    throw Exception::FromSource(error);
+#else
+    throw std::forward<Error>(error);
+#endif
+}
+
+// 오류에 컨텍스트 프레임을 추가해 상위로 전달 (CONTEXTUAL_TRY 용)
+// - lvalue Result 의 오류는 복사, rvalue 는 체인 소유권을 그대로 이동
+// - 메시지 인자는 보관만 하고 what() 등 최초 조회 시 포맷
+template <int Placeholders, typename... Values>
+inline Unexpected Propagate(::ContextualException error,
+                            const SourceSite& site, int code,
+                            const char* format, Values&&... values) {
+    static_assert(FormatArgumentsCheck<Placeholders, sizeof...(Values)>::value,
+                  "invalid format arguments");
+    error.AddFormattedContext(site, code, format,
+                              std::forward<Values>(values)...);
+    return Unexpected(std::move(error));
+}
+
+}  // namespace anonymous
+
+// API 경계에서 값을 꺼내거나 오류를 contextual_exception::Exception 으로 throw
+// (ContextualException 이면 프레임 체인은 복사하지 않고 그대로 던짐)
+template <typename Value>
+inline Value ValueOrThrow(Result<Value>&& result) {
+    if (!result) {
+        anonymous::ThrowError(std::move(result).error());
+    }
+    return *std::move(result);
+}
+
+template <typename Value>
+inline const Value& ValueOrThrow(const Result<Value>& result) {
+    if (!result) {
+        anonymous::ThrowError(result.error());
+    }
+    return *result;
+}
+
+inline void ValueOrThrow(const Result<void>& result) {
+    if (!result) {
+        anonymous::ThrowError(result.error());
+    }
+}
+
+}  // namespace contextual_exception
+
+// 오류 Result 생성 (Result<T> 를 반환하는 함수에서 return 으로 사용)
+// usecase 1) return CONTEXTUAL_ERROR(message, code);
+// usecase 2) return CONTEXTUAL_ERROR(message);
+#define CONTEXTUAL_ERROR(...)                    \
+    ::contextual_exception::Unexpected(          \
+        ::contextual_exception::anonymous::Make( \
+            *__CONTEXTUAL_FUNCTION_SOURCE_SITE(), __VA_ARGS__))
+
+// usecase) return CONTEXTUAL_ERROR_F("unexpected token '{}'", token);
+#define CONTEXTUAL_ERROR_F(...) CONTEXTUAL_ERROR_CODE_F(0, __VA_ARGS__)
+// usecase) return CONTEXTUAL_ERROR_CODE_F(code, "unexpected token", token);
+#define CONTEXTUAL_ERROR_CODE_F(code, ...)                              \
+    ::contextual_exception::Unexpected(                                 \
+        ::contextual_exception::anonymous::MakeFormatted<               \
+            ::contextual_exception::anonymous::CountFormatPlaceholders( \
+                __CONTEXTUAL_FIRST_ARGUMENT(__VA_ARGS__))>(             \
+            *__CONTEXTUAL_FUNCTION_SOURCE_SITE(), code, __VA_ARGS__))
+
+// expression(Result) 이 오류이면 컨텍스트 프레임을 추가해 즉시 return
+// - 메시지는 CONTEXTUAL_EXCEPTION_F 와 같은 형식 문자열 (리터럴, "" 허용)
+// - 메시지 인자는 오류일 때만 평가
+// usecase) CONTEXTUAL_TRY(Flush(file), "flush {}", path);
+#define CONTEXTUAL_TRY(expression, ...) \
+    CONTEXTUAL_TRY_CODE(expression, 0, __VA_ARGS__)
+// usecase) CONTEXTUAL_TRY_CODE(Flush(file), EIO, "flush {}", path);
+#define CONTEXTUAL_TRY_CODE(expression, code, ...)                   \
+    do {                                                             \
+        auto&& __contextual_result = (expression);                   \
+        if (!__contextual_result) {                                  \
+            return __CONTEXTUAL_PROPAGATE(__contextual_result, code, \
+                                          __VA_ARGS__);              \
+        }                                                            \
+    } while (0)
+
+// 성공 값을 lhs 에 대입(선언 가능), 오류이면 CONTEXTUAL_TRY 와 같이 return
+// usecase) CONTEXTUAL_TRY_ASSIGN(auto token, NextToken(input), "header");
+#define CONTEXTUAL_TRY_ASSIGN(lhs, expression, ...) \
+    CONTEXTUAL_TRY_ASSIGN_CODE(lhs, expression, 0, __VA_ARGS__)
+// usecase) CONTEXTUAL_TRY_ASSIGN_CODE(auto token, NextToken(in), 22, "hdr");
+#define CONTEXTUAL_TRY_ASSIGN_CODE(lhs, expression, code, ...)    \
+    __CONTEXTUAL_TRY_ASSIGN_IMPL(                                 \
+        __CONTEXTUAL_CONCAT(__contextual_result_, __LINE__), lhs, \
+        expression, code, __VA_ARGS__)
+#define __CONTEXTUAL_TRY_ASSIGN_IMPL(result, lhs, expression, code, ...) \
+    auto&& result = (expression);                                        \
+    if (!result) {                                                       \
+        return __CONTEXTUAL_PROPAGATE(result, code, __VA_ARGS__);        \
+    }                                                                    \
+    lhs = *std::forward<decltype(result)>(result)
+
+// 내부 구현: result 의 오류에 프레임을 추가한 Unexpected
+#define __CONTEXTUAL_PROPAGATE(result, code, ...)                   \
+    ::contextual_exception::anonymous::Propagate<                   \
+        ::contextual_exception::anonymous::CountFormatPlaceholders( \
+            __CONTEXTUAL_FIRST_ARGUMENT(__VA_ARGS__))>(             \
+        std::forward<decltype(result)>(result).error(),             \
+        *__CONTEXTUAL_FUNCTION_SOURCE_SITE(), code, __VA_ARGS__)
+
+#endif  //__CONTEXTUAL_RESULT_HPP__
@@ -0,0 +1,115 @@
+#ifndef __CONTEXTUAL_SITE_COUNTERS_HPP__
+#define __CONTEXTUAL_SITE_COUNTERS_HPP__
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "ContextualException.hpp"
+
+// 호출 지점별 예외 생성 횟수 조회
+// - CONTEXTUAL_EXCEPTION_SITE_COUNTERS 를 정의한 번역 단위의 매크로 호출
+//   지점만 집계 (미정의 시 항상 비어 있음)
+// - 로그 없이 어느 줄이 초당 몇 번 던지는지 확인하는 용도
+// usecase)
+//   auto before = contextual_exception::SnapshotSiteCounts();
+//   ... (일정 시간 경과)
+//   auto delta = contextual_exception::SiteCountsSince(before);
+//   for (auto& site : delta.sites) {
+//       // site.site->file, site.site->line, site.count / delta.seconds
+//   }
+
+namespace contextual_exception {
+
+struct SiteCount {
+    // 항상 유효 (정적 레코드 또는 InternSourceSite 레코드)
+    const SourceSite* site;
+    std::uint64_t count;
+    // (code, 횟수): 지점에서 먼저 나온 SiteCounter::kCodeSlots 개까지
+    std::vector<std::pair<int, std::uint64_t>> codes;
+    // codes 에 들지 못한 코드의 횟수 합
+    std::uint64_t other_codes;
+};
+
+struct SiteCountSnapshot {
+    std::chrono::steady_clock::time_point time;
+    // 등록 역순
+    std::vector<SiteCount> sites;
+};
+
+struct SiteCountDelta {
+    // 두 스냅샷 사이 경과 시간 (초당 비율 = count / seconds)
+    double seconds;
+    // 증가한 지점만, 증가량 내림차순
+    std::vector<SiteCount> sites;
+};
+
+// 등록된 모든 지점의 현재 값
+// - 락 없이 읽으므로 지점 간 값이 같은 순간의 값은 아님
+inline SiteCountSnapshot SnapshotSiteCounts() {
+    SiteCountSnapshot snapshot;
+    snapshot.time = std::chrono::steady_clock::now();
+    for (const SiteCounter* counter = SiteCounter::First(); counter;
+         counter = counter->Next()) {
+        SiteCount site;
+        site.site = counter->Site();
+        site.count = counter->Count();
+        for (std::size_t ii = 0; ii < SiteCounter::kCodeSlots; ++ii) {
+            int code = 0;
+            std::uint64_t count = 0;
+            if (counter->CodeCount(ii, &code, &count)) {
+                site.codes.push_back(std::make_pair(code, count));
+            }
+        }
+        site.other_codes = counter->OtherCodeCount();
+        snapshot.sites.push_back(std::move(site));
+    }
+    return snapshot;
+}
+
+// before 이후 증가분 (before 이후 등록된 지점은 전체 값)
+inline SiteCountDelta SiteCountsSince(const SiteCountSnapshot& before) {
+    const SiteCountSnapshot after = SnapshotSiteCounts();
+
+    std::unordered_map<const SourceSite*, const SiteCount*> previous;
+    for (const SiteCount& site : before.sites) {
+        previous[site.site] = &site;
+    }
+
+    SiteCountDelta delta;
+    delta.seconds =
+        std::chrono::duration<double>(after.time - before.time).count();
+    for (const SiteCount& site : after.sites) {
+        SiteCount increase = site;
+        auto found = previous.find(site.site);
+        if (previous.end() != found) {
+            const SiteCount& old = *found->second;
+            increase.count -= old.count;
+            increase.other_codes -= old.other_codes;
+            for (auto& code : increase.codes) {
+                for (const auto& old_code : old.codes) {
+                    if (old_code.first == code.first) {
+                        code.second -= old_code.second;
+                        break;
+                    }
+                }
+            }
+        }
+        if (0 != increase.count) {
+            delta.sites.push_back(std::move(increase));
+        }
+    }
+    std::stable_sort(delta.sites.begin(), delta.sites.end(),
+                     [](const SiteCount& left, const SiteCount& right) {
+                         return left.count > right.count;
+                     });
+    return delta;
+}
+
+}  // namespace contextual_exception
+
+#endif  //__CONTEXTUAL_SITE_COUNTERS_HPP__
@@ -0,0 +1,276 @@
+#ifndef __CONTEXTUAL_STRUCTURED_LOG_HPP__
+#define __CONTEXTUAL_STRUCTURED_LOG_HPP__
+
+#include <cstddef>
+#include <cstring>
+#include <string>
+
+#include "ContextualException.hpp"
+
+// 프레임 체인의 구조화 로그 출력 (JSON, logfmt)
+// - 텍스트(DetailedErrorMessage)를 다시 파싱하지 않고 필드를 그대로 기록
+// - 로케일, 스트림 없이 재사용 버퍼(std::string, char 배열)에 직접 기록
+// - depth: 기본 프레임 0, 이후 하위 프레임마다 1 증가
+//   (std::throw_with_nested 로 중첩된 예외의 프레임도 이어서 기록)
+//   (FixedContextualException 이 생략한 프레임만큼 건너뜀)
+// - 문자열의 바이트는 그대로 기록 (UTF-8 검증 없음)
+// JSON)
+//   {"frames":[{"depth":0,"code":3,"file":"a.cpp","line":10,
+//               "function":"Run","message":"query failed"},...],
+//    "omitted_frames":2}                       (생략된 프레임이 있을 때만)
+// logfmt) 프레임마다 한 줄
+//   depth=0 code=3 file=a.cpp line=10 function=Run message="query failed"
+//   omitted_frames=2                           (생략된 프레임이 있을 때만)
+// usecase)
+//   thread_local std::string line;
+//   line.clear();
+//   contextual_exception::AppendFramesJson(exception, &line);
+
+namespace contextual_exception {
+namespace anonymous {
+
+// text 를 JSON 문자열로 (따옴표 포함)
+// - 이스케이프가 필요 없는 구간은 한 번에 기록
+template <typename Writer>
+inline void AppendJsonString(Writer* writer, TextView text) {
+    static const char kHex[] = "0123456789abcdef";
+    writer->Append("\"", 1);
+    const char* run = text.data;
+    const char* const end = text.data + text.size;
+    for (const char* it = text.data; it != end; ++it) {
+        const unsigned char byte = static_cast<unsigned char>(*it);
+        if (CONTEXTUAL_LIKELY(byte >= 0x20 && '"' != byte && '\\' != byte)) {
+            continue;
+        }
+        writer->Append(run, static_cast<std::size_t>(it - run));
+        run = it + 1;
+        switch (byte) {
+            case '"':
+                writer->Append("\\\"", 2);
+                break;
+            case '\\':
+                writer->Append("\\\\", 2);
+                break;
+            case '\n':
+                writer->Append("\\n", 2);
+                break;
+            case '\r':
+                writer->Append("\\r", 2);
+                break;
+            case '\t':
+                writer->Append("\\t", 2);
+                break;
+            default: {
+                const char escaped[6] = {'\\', 'u', '0', '0', kHex[byte >> 4],
+                                         kHex[byte & 0xf]};
+                writer->Append(escaped, sizeof(escaped));
+                break;
+            }
+        }
+    }
+    writer->Append(run, static_cast<std::size_t>(end - run));
+    writer->Append("\"", 1);
+}
+
+// text 를 logfmt 값으로
+// - 공백, '=', '"', 제어 문자가 있거나 비어 있으면 따옴표로 감쌈
+template <typename Writer>
+inline void AppendLogfmtValue(Writer* writer, TextView text) {
+    const char* const end = text.data + text.size;
+    bool quote = 0 == text.size;
+    for (const char* it = text.data; !quote && it != end; ++it) {
+        const unsigned char byte = static_cast<unsigned char>(*it);
+        quote = byte <= 0x20 || '=' == byte || '"' == byte || 0x7f == byte;
+    }
+    if (!quote) {
+        writer->Append(text.data, text.size);
+        return;
+    }
+    // 따옴표 안은 JSON 문자열과 같은 규칙
+    AppendJsonString(writer, text);
+}
+
+enum StructuredLogFormat { kJson, kLogfmt };
+
+// 프레임을 차례로 JSON 또는 logfmt 로 기록하는 FrameSink
+// (모든 프레임을 받은 뒤 Finish 호출)
+template <typename Writer>
+class StructuredFrameSink : public FrameSink {
+   public:
+    StructuredFrameSink(Writer* writer, StructuredLogFormat format)
+        : writer_(writer), format_(format), depth_(0), omitted_frames_(0) {
+        if (kJson == format_) {
+            writer_->Append("{\"frames\":[");
+        }
+    }
+
+    virtual void AddFrame(const char* message, int code,
+                          const SourceSite& site) override {
+        WriteFrame(site, code, message);
+    }
+    virtual void AddFrames(const ::ContextualException& exception) override {
+        const ::ContextualException::Frame& base_frame = exception.BaseFrame();
+        WriteFrame(*base_frame.site, base_frame.code, base_frame.Message());
+        for (const ::ContextualException::FrameNode* node =
+                 exception.ChildFrames();
+             node; node = node->next.get()) {
+            WriteFrame(*node->frame.site, node->frame.code,
+                       node->frame.Message());
+        }
+    }
+    virtual void AddOmittedFrames(std::size_t count) override {
+        depth_ += count;
+        omitted_frames_ += count;
+    }
+
+    void Finish() {
+        if (kJson == format_) {
+            writer_->Append("]");
+            if (0 != omitted_frames_) {
+                writer_->Append(",\"omitted_frames\":");
+                writer_->AppendInteger(
+                    static_cast<long long>(omitted_frames_));
+            }
+            writer_->Append("}");
+        } else if (0 != omitted_frames_) {
+            writer_->Append("omitted_frames=");
+            writer_->AppendInteger(static_cast<long long>(omitted_frames_));
+            writer_->Append("\n");
+        }
+    }
+
+   private:
+    void WriteFrame(const SourceSite& site, int code, TextView message) {
+        if (kJson == format_) {
+            writer_->Append(0 == depth_ ? "{\"depth\":" : ",{\"depth\":");
+            writer_->AppendInteger(static_cast<long long>(depth_));
+            writer_->Append(",\"code\":");
+            writer_->AppendInteger(code);
+            writer_->Append(",\"file\":");
+            AppendJsonString(writer_, site.file);
+            writer_->Append(",\"line\":");
+            writer_->AppendInteger(site.line);
+            writer_->Append(",\"function\":");
+            AppendJsonString(writer_, site.function);
+            writer_->Append(",\"message\":");
+            AppendJsonString(writer_, message);
+            writer_->Append("}");
+        } else {
+            writer_->Append("depth=");
+            writer_->AppendInteger(static_cast<long long>(depth_));
+            writer_->Append(" code=");
+            writer_->AppendInteger(code);
+            writer_->Append(" file=");
+            AppendLogfmtValue(writer_, site.file);
+            writer_->Append(" line=");
+            writer_->AppendInteger(site.line);
+            writer_->Append(" function=");
+            AppendLogfmtValue(writer_, site.function);
+            writer_->Append(" message=");
+            AppendLogfmtValue(writer_, message);
+            writer_->Append("\n");
+        }
+        ++depth_;
+    }
+
+    Writer* writer_;
+    StructuredLogFormat format_;
+    std::size_t depth_;
+    std::size_t omitted_frames_;
+};
+
+template <typename Writer>
+inline void WriteStructuredFrames(const FrameSource& exception,
+                                  StructuredLogFormat format, Writer* writer) {
+    StructuredFrameSink<Writer> sink(writer, format);
+    VisitSourceFrames(exception, &sink);
+    sink.Finish();
+}
+
+// std::string 뒤에 추가하는 작성기
+// - 조각이 작고 많으므로 스택 버퍼에 모아 한 번에 append
+class StringAppendWriter {
+   public:
+    explicit StringAppendWriter(std::string* output)
+        : output_(output), size_(0) {}
+    StringAppendWriter(const StringAppendWriter&) = delete;
+    StringAppendWriter& operator=(const StringAppendWriter&) = delete;
+    ~StringAppendWriter() {
+        Flush();
+    }
+
+    void Append(const char* text, std::size_t size) {
+        if (sizeof(buffer_) - size_ < size) {
+            Flush();
+            if (sizeof(buffer_) < size) {
+                output_->append(text, size);
+                return;
+            }
+        }
+        std::memcpy(buffer_ + size_, text, size);
+        size_ += size;
+    }
+    void Append(const char* text) {
+        Append(text, std::strlen(text));
+    }
+    void AppendInteger(long long value) {
+        char digits[24];
+        BufferWriter writer(digits, sizeof(digits));
+        writer.AppendInteger(value);
+        Append(writer.Data(), writer.Size());
+    }
+
+    void Flush() {
+        output_->append(buffer_, size_);
+        size_ = 0;
+    }
+
+   private:
+    std::string* output_;
+    char buffer_[256];
+    std::size_t size_;
+};
+
+inline void AppendStructuredFrames(const FrameSource& exception,
+                                   StructuredLogFormat format,
+                                   std::string* output) {
+    StringAppendWriter writer(output);
+    WriteStructuredFrames(exception, format, &writer);
+}
+
+}  // namespace anonymous
+
+// exception 의 프레임 체인을 JSON 객체 하나로 output 뒤에 추가
+inline void AppendFramesJson(const FrameSource& exception,
+                             std::string* output) {
+    anonymous::AppendStructuredFrames(exception, anonymous::kJson, output);
+}
+
+// exception 의 프레임 체인을 buffer 에 NUL 종료 JSON 으로 기록
+// - 잘리지 않았다면 필요한 길이를 반환 (snprintf 와 같은 규칙,
+//   잘린 결과는 올바른 JSON 이 아님)
+inline std::size_t WriteFramesJson(const FrameSource& exception, char* buffer,
+                                   std::size_t capacity) {
+    anonymous::BufferWriter writer(buffer, capacity);
+    anonymous::WriteStructuredFrames(exception, anonymous::kJson, &writer);
+    return writer.RequiredSize();
+}
+
+// exception 의 프레임 체인을 프레임당 logfmt 한 줄로 output 뒤에 추가
+inline void AppendFramesLogfmt(const FrameSource& exception,
+                               std::string* output) {
+    anonymous::AppendStructuredFrames(exception, anonymous::kLogfmt, output);
+}
+
+// exception 의 프레임 체인을 buffer 에 NUL 종료 logfmt 로 기록
+// (반환값은 WriteFramesJson 과 같은 규칙)
+inline std::size_t WriteFramesLogfmt(const FrameSource& exception,
+                                     char* buffer, std::size_t capacity) {
+    anonymous::BufferWriter writer(buffer, capacity);
+    anonymous::WriteStructuredFrames(exception, anonymous::kLogfmt, &writer);
+    return writer.RequiredSize();
+}
+
+}  // namespace contextual_exception
+
+#endif  //__CONTEXTUAL_STRUCTURED_LOG_HPP__
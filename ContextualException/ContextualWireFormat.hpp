@@ -0,0 +1,330 @@
+#ifndef __CONTEXTUAL_WIRE_FORMAT_HPP__
+#define __CONTEXTUAL_WIRE_FORMAT_HPP__
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "ContextualException.hpp"
+
+// 프레임 체인의 이진 직렬화 (RPC, 프로세스 경계 전달용)
+// - 텍스트(DetailedErrorMessage)와 달리 프레임 구조가 그대로 복원됨
+// - 형식 (정수는 LEB128 varint, 부호 있는 값은 zigzag)
+//     "CE" 버전(1바이트) 프레임수
+//     프레임* : file function line code message  (기본 프레임부터 순서대로)
+//   깊이는 저장하지 않고 순서로 결정
+// - 문자열: 태그 varint
+//     짝수: 인라인, 길이 = 태그 >> 1, 이어서 바이트
+//     홀수: 앞서 인라인으로 기록된 같은 문자열의 태그 위치 (태그 >> 1,
+//           첫 프레임 시작 기준)
+//   file, function 만 중복 제거 (message 는 항상 인라인)
+// - std::throw_with_nested 로 중첩된 예외의 프레임도 이어서 기록
+// - FixedContextualException 의 생략된 프레임 수는 기록하지 않음
+// usecase)
+//   std::string payload;
+//   contextual_exception::EncodeFrames(exception, &payload);
+//   ...
+//   ContextualException received;
+//   if (contextual_exception::DecodeFrames(data, size, &received)) {
+//       throw received;
+//   }
+
+namespace contextual_exception {
+
+enum { kWireFormatVersion = 1 };
+
+namespace anonymous {
+
+inline void AppendVarint(std::string* output, std::uint64_t value) {
+    while (value >= 0x80) {
+        output->push_back(static_cast<char>((value & 0x7f) | 0x80));
+        value >>= 7;
+    }
+    output->push_back(static_cast<char>(value));
+}
+
+inline std::uint64_t ZigZag(int value) {
+    return (static_cast<std::uint64_t>(static_cast<std::int64_t>(value)) << 1) ^
+           static_cast<std::uint64_t>(static_cast<std::int64_t>(value) >> 63);
+}
+
+// 프레임을 차례로 직렬화하는 FrameSink (끝나면 Finish 호출)
+class WireEncoder : public FrameSink {
+   public:
+    explicit WireEncoder(std::string* output)
+        : output_(output), start_(output->size() + 3), frame_count_(0) {
+        output_->append("CE", 2);
+        output_->push_back(static_cast<char>(kWireFormatVersion));
+    }
+
+    // 프레임 수를 헤더 뒤에 삽입
+    void Finish() {
+        std::string frame_count;
+        AppendVarint(&frame_count, frame_count_);
+        output_->insert(start_, frame_count);
+    }
+
+    virtual void AddFrame(const char* message, int code,
+                          const SourceSite& site) override {
+        AppendFrame(site, code, message);
+    }
+    virtual void AddFrames(const ::ContextualException& exception) override {
+        const ::ContextualException::Frame& base_frame = exception.BaseFrame();
+        AppendFrame(*base_frame.site, base_frame.code, base_frame.Message());
+        for (const ::ContextualException::FrameNode* node =
+                 exception.ChildFrames();
+             node; node = node->next.get()) {
+            AppendFrame(*node->frame.site, node->frame.code,
+                        node->frame.Message());
+        }
+    }
+
+   private:
+    void AppendFrame(const SourceSite& site, int code, TextView message) {
+        AppendSharedString(site.file);
+        AppendSharedString(site.function);
+        AppendVarint(output_, ZigZag(site.line));
+        AppendVarint(output_, ZigZag(code));
+        AppendString(message);
+        ++frame_count_;
+    }
+
+    void AppendString(TextView text) {
+        AppendVarint(output_, static_cast<std::uint64_t>(text.size) << 1);
+        output_->append(text.data, text.size);
+    }
+
+    // 같은 내용이 이미 기록되었으면 그 위치만 기록
+    // (체인의 file, function 은 수가 적어 선형 탐색)
+    void AppendSharedString(TextView text) {
+        if (0 != text.size) {
+            for (const auto& written : strings_) {
+                if (written.first.size == text.size &&
+                    0 == std::memcmp(written.first.data, text.data,
+                                     text.size)) {
+                    AppendVarint(output_, (written.second << 1) | 1);
+                    return;
+                }
+            }
+            strings_.push_back(std::make_pair(
+                text, static_cast<std::uint64_t>(output_->size() - start_)));
+        }
+        AppendString(text);
+    }
+
+    std::string* output_;
+    std::size_t start_;
+    std::uint64_t frame_count_;
+    std::vector<std::pair<TextView, std::uint64_t>> strings_;
+};
+
+}  // namespace anonymous
+
+// 직렬화된 프레임 하나 (문자열은 입력 버퍼를 가리킴, NUL 종료 아님)
+struct WireFrame {
+    typedef anonymous::TextView TextView;
+
+    TextView file;
+    TextView function;
+    int line;
+    int code;
+    TextView message;
+
+    WireFrame()
+        : file("", 0), function("", 0), line(0), code(0), message("", 0) {}
+};
+
+// 복사, 할당 없이 입력 버퍼에서 프레임을 차례로 읽음
+// - 입력 버퍼는 읽은 WireFrame 을 사용하는 동안 유지되어야 함
+// - 잘못된 입력(잘림, 남는 바이트, 범위 밖 참조, 다른 버전)은 Failed()
+class WireFrameReader {
+   public:
+    WireFrameReader(const char* data, std::size_t size)
+        : data_(reinterpret_cast<const unsigned char*>(data)),
+          size_(size),
+          position_(3),
+          start_(0),
+          frame_count_(0),
+          read_count_(0),
+          failed_(size < 3 || 'C' != data[0] || 'E' != data[1] ||
+                  kWireFormatVersion != static_cast<unsigned char>(data[2])) {
+        // 프레임은 최소 5바이트
+        std::uint64_t frame_count = 0;
+        if (!failed_ && (!ReadVarint(&position_, &frame_count) ||
+                         frame_count > (size_ - position_) / 5)) {
+            failed_ = true;
+        }
+        start_ = position_;
+        frame_count_ = static_cast<std::size_t>(frame_count);
+    }
+
+    // 헤더에 기록된 프레임 수 (실패 시 의미 없음)
+    std::size_t FrameCount() const {
+        return frame_count_;
+    }
+
+    // 다음 프레임 (끝이거나 실패하면 false)
+    bool Next(WireFrame* frame) {
+        if (failed_) {
+            return false;
+        }
+        if (frame_count_ == read_count_) {
+            failed_ = size_ != position_;
+            return false;
+        }
+        std::uint64_t line = 0;
+        std::uint64_t code = 0;
+        if (!ReadSharedString(&frame->file) ||
+            !ReadSharedString(&frame->function) ||
+            !ReadVarint(&position_, &line) || !ReadVarint(&position_, &code) ||
+            !ReadString(&position_, &frame->message) ||
+            !ToInt(line, &frame->line) || !ToInt(code, &frame->code)) {
+            failed_ = true;
+            return false;
+        }
+        ++read_count_;
+        return true;
+    }
+
+    bool Failed() const {
+        return failed_;
+    }
+
+   private:
+    typedef anonymous::TextView TextView;
+
+    bool ReadVarint(std::size_t* position, std::uint64_t* value) const {
+        *value = 0;
+        for (unsigned shift = 0; shift < 64 && *position < size_; shift += 7) {
+            const unsigned char byte = data_[(*position)++];
+            *value |= static_cast<std::uint64_t>(byte & 0x7f) << shift;
+            if (0 == (byte & 0x80)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool ReadString(std::size_t* position, TextView* text) const {
+        std::uint64_t tag = 0;
+        if (!ReadVarint(position, &tag) || 0 != (tag & 1) ||
+            (tag >> 1) > size_ - *position) {
+            return false;
+        }
+        const std::size_t size = static_cast<std::size_t>(tag >> 1);
+        *text =
+            TextView(reinterpret_cast<const char*>(data_) + *position, size);
+        *position += size;
+        return true;
+    }
+
+    // 참조는 앞서 나온 인라인 문자열만 가리킬 수 있음 (순환 불가)
+    bool ReadSharedString(TextView* text) {
+        std::size_t position = position_;
+        std::uint64_t tag = 0;
+        if (!ReadVarint(&position, &tag)) {
+            return false;
+        }
+        if (0 == (tag & 1)) {
+            return ReadString(&position_, text);
+        }
+        position_ = position;
+        if ((tag >> 1) >= position_ - start_) {
+            return false;
+        }
+        std::size_t referenced = start_ + static_cast<std::size_t>(tag >> 1);
+        return ReadString(&referenced, text);
+    }
+
+    static bool ToInt(std::uint64_t zigzag, int* value) {
+        const std::int64_t decoded = static_cast<std::int64_t>(zigzag >> 1) ^
+                                     -static_cast<std::int64_t>(zigzag & 1);
+        *value = static_cast<int>(decoded);
+        return *value == decoded;
+    }
+
+    const unsigned char* data_;
+    std::size_t size_;
+    std::size_t position_;
+    std::size_t start_;
+    std::size_t frame_count_;
+    std::size_t read_count_;
+    bool failed_;
+};
+
+// exception 의 프레임 체인을 output 뒤에 직렬화
+template <typename Source, typename = anonymous::EnableIfFrameSource<Source>>
+inline void EncodeFrames(const Source& exception, std::string* output) {
+    anonymous::WireEncoder encoder(output);
+    anonymous::VisitSourceFrames(exception, &encoder);
+    encoder.Finish();
+}
+
+// FrameSource 가 아니면 what() 만 위치 정보 없는 프레임 하나로
+inline void EncodeFrames(const std::exception& exception,
+                         std::string* output) {
+    const FrameSource* source = anonymous::AsFrameSource(exception);
+    if (source) {
+        EncodeFrames<FrameSource>(*source, output);
+        return;
+    }
+    static const SourceSite empty_site = {"", "", 0, nullptr};
+    const int default_code = 0;
+    anonymous::WireEncoder encoder(output);
+    encoder.AddFrame(exception.what(), default_code, empty_site);
+    encoder.Finish();
+}
+
+enum { kMaxDecodedSites = 4096 };
+
+// 직렬화된 프레임 체인으로 exception 복원 (잘못된 입력이면 false)
+// - 위치 정보는 InternSourceSite 로 등록 (같은 지점은 한 번만 할당)
+// - 상대가 보낸 임의의 위치로 등록 레코드가 끝없이 늘지 않도록, 레코드가
+//   max_sites 개 이상이면 새 위치는 등록하지 않고 위치 정보 없는 프레임의
+//   메시지 앞에 "file:line | function() | " 로 보존
+//   (Frame::site 를 보관하는 RateLimiter, FlightRecorder 등이 예외보다 오래
+//    참조할 수 있으므로 예외가 소유하는 위치 정보는 쓰지 않음)
+inline bool DecodeFrames(const char* data, std::size_t size,
+                         ::ContextualException* exception,
+                         std::size_t max_sites = kMaxDecodedSites) {
+    static const SourceSite empty_site = {"", "", 0, nullptr};
+    WireFrameReader reader(data, size);
+    std::vector<::ContextualException::Frame> frames;
+    frames.reserve(reader.FrameCount());
+    WireFrame frame;
+    while (reader.Next(&frame)) {
+        const std::string file(frame.file.data, frame.file.size);
+        const std::string function(frame.function.data, frame.function.size);
+        const SourceSite* site =
+            TryInternSourceSite(file, frame.line, function, max_sites);
+        std::string message;
+        if (!site) {
+            const SourceSite remote_site = {file.c_str(), function.c_str(),
+                                            frame.line, nullptr};
+            const auto append = [&message](const char* text,
+                                           std::size_t text_size) {
+                message.append(text, text_size);
+            };
+            anonymous::AppendWriter<decltype(append)> writer(append);
+            anonymous::WriteFrameText(&writer, remote_site, 0, frame.message);
+            site = &empty_site;
+        } else {
+            message.assign(frame.message.data, frame.message.size);
+        }
+        frames.push_back(::ContextualException::Frame(std::move(message),
+                                                      frame.code, *site));
+    }
+    if (reader.Failed()) {
+        return false;
+    }
+    *exception = ::ContextualException::FromFrames(std::move(frames));
+    return true;
+}
+
+}  // namespace contextual_exception
+
+#endif  //__CONTEXTUAL_WIRE_FORMAT_HPP__
@@ -0,0 +1,653 @@
+#ifndef __FIXED_CONTEXTUAL_EXCEPTION_HPP__
+#define __FIXED_CONTEXTUAL_EXCEPTION_HPP__
+
+#include <atomic>
+#include <cstddef>
+#include <cstring>
+#include <exception>
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <thread>
+#include <type_traits>
+
+#include "ContextualException.hpp"
+
+// CONTEXTUAL_EXCEPTION_USE_FIXED_CAPACITY 정의 시 매크로가 생성하는 예외 용량
+#ifndef CONTEXTUAL_EXCEPTION_FIXED_FRAMES
+#define CONTEXTUAL_EXCEPTION_FIXED_FRAMES 8
+#endif
+#ifndef CONTEXTUAL_EXCEPTION_FIXED_MESSAGE_BYTES
+#define CONTEXTUAL_EXCEPTION_FIXED_MESSAGE_BYTES 128
+#endif
+
+namespace contextual_exception {
+namespace anonymous {
+
+// 고정 버퍼에 출력하는 streambuf (넘치면 이후 출력 무시)
+class BufferStreamBuffer : public std::streambuf {
+   public:
+    BufferStreamBuffer(char* buffer, std::size_t capacity)
+        : writer_(buffer, capacity) {}
+
+    const BufferWriter& Writer() const {
+        return writer_;
+    }
+
+   protected:
+    virtual std::streamsize xsputn(const char* text,
+                                   std::streamsize size) override {
+        writer_.Append(text, static_cast<std::size_t>(size));
+        return size;
+    }
+    virtual int_type overflow(int_type character) override {
+        if (!traits_type::eq_int_type(character, traits_type::eof())) {
+            const char value = traits_type::to_char_type(character);
+            writer_.Append(&value, 1);
+        }
+        return traits_type::not_eof(character);
+    }
+
+   private:
+    BufferWriter writer_;
+};
+
+inline void WriteFormat(std::ostream& stream, const char* format) {
+    WriteFormatText(stream, format);
+}
+template <typename First, typename... Rest>
+inline void WriteFormat(std::ostream& stream, const char* format,
+                        const First& first, const Rest&... rest) {
+    const char* next = WriteFormatText(stream, format);
+    if (!next) {
+        return;
+    }
+    stream << first;
+    WriteFormat(stream, next, rest...);
+}
+
+}  // namespace anonymous
+
+// 동적 할당 없는 고정 용량 ContextualException
+// - 프레임 MaxFrames 개, 프레임당 메시지 MaxMessageBytes 바이트(NUL 포함)를
+//   객체 안에 보관
+// - 넘치는 메시지는 UTF-8 문자 경계에서 잘라내고, 넘치는 프레임은 기본 프레임
+//   바로 아래에서 생략하며 개수만 기록
+// - std::bad_alloc 보고, 할당을 피해야 하는 지연 시간 민감 경로용
+template <std::size_t MaxFrames, std::size_t MaxMessageBytes>
+class FixedContextualException : public std::exception, public FrameSource {
+    static_assert(MaxFrames >= 1, "MaxFrames must be at least 1");
+    static_assert(MaxMessageBytes >= 1, "MaxMessageBytes must be at least 1");
+
+   public:
+    typedef contextual_exception::SourceSite SourceSite;
+    typedef contextual_exception::anonymous::TextView TextView;
+
+    // 추적 프레임
+    struct Frame {
+        const SourceSite* site;
+        int code;
+        // 메시지가 용량을 넘어 잘렸는지 여부
+        bool truncated;
+        char message[MaxMessageBytes];
+    };
+    // 프레임 이동/복사는 memmove/memcpy 로 처리
+    static_assert(std::is_trivially_copyable<Frame>::value,
+                  "Frame must be trivially copyable");
+
+   public:
+    FixedContextualException()
+        : frame_count_(0), omitted_frames_(0), what_state_(kWhatEmpty) {}
+    FixedContextualException(TextView message, const SourceSite& site)
+        : FixedContextualException() {
+        const int default_code = 0;
+        SetBaseFrame(message, default_code, site);
+    }
+    FixedContextualException(TextView message, int code,
+                             const SourceSite& site)
+        : FixedContextualException() {
+        SetBaseFrame(message, code, site);
+    }
+    FixedContextualException(TextView message,
+                             const std::exception& exception,
+                             const SourceSite& site)
+        : FixedContextualException() {
+        const int default_code = 0;
+        SetBaseFrame(message, default_code, site);
+        WrapException(exception);
+    }
+    FixedContextualException(TextView message, int code,
+                             const std::exception& exception,
+                             const SourceSite& site)
+        : FixedContextualException() {
+        SetBaseFrame(message, code, site);
+        WrapException(exception);
+    }
+
+    // 정적 타입이 FrameSource 파생이면 캐스트 없이 프레임을 넘겨받음
+    template <typename Source,
+              typename = anonymous::EnableIfFrameSource<Source>>
+    FixedContextualException(TextView message, const Source& source,
+                             const SourceSite& site)
+        : FixedContextualException() {
+        const int default_code = 0;
+        SetBaseFrame(message, default_code, site);
+        WrapFrameSource(source);
+    }
+    template <typename Source,
+              typename = anonymous::EnableIfFrameSource<Source>>
+    FixedContextualException(TextView message, int code, const Source& source,
+                             const SourceSite& site)
+        : FixedContextualException() {
+        SetBaseFrame(message, code, site);
+        WrapFrameSource(source);
+    }
+    // 같은 타입은 잘림 표시와 생략 개수까지 그대로 복사
+    FixedContextualException(TextView message,
+                             const FixedContextualException& exception,
+                             const SourceSite& site)
+        : FixedContextualException() {
+        const int default_code = 0;
+        SetBaseFrame(message, default_code, site);
+        WrapFixedException(exception);
+    }
+    FixedContextualException(TextView message, int code,
+                             const FixedContextualException& exception,
+                             const SourceSite& site)
+        : FixedContextualException() {
+        SetBaseFrame(message, code, site);
+        WrapFixedException(exception);
+    }
+
+    FixedContextualException(const FixedContextualException& other)
+        : std::exception(other), FrameSource(other) {
+        CopyFrom(other);
+    }
+    FixedContextualException& operator=(const FixedContextualException& other) {
+        if (this != &other) {
+            CopyFrom(other);
+        }
+        return *this;
+    }
+
+    virtual ~FixedContextualException() CONTEXTUAL_EXCEPTION_NOEXCEPT {};
+
+    // source 의 프레임을 그대로 가진 예외 (Result 의 오류를 throw 할 때 등)
+    // - 새로 발생한 예외가 아니므로 호출 지점 카운터에 기록하지 않음
+    // - 넘치는 프레임은 기본 프레임 바로 아래에서 생략
+    static FixedContextualException FromSource(const FrameSource& source) {
+        FixedContextualException exception;
+        FrameCopier copier(&exception);
+        source.VisitFrames(&copier);
+#if defined(__GXX_RTTI) || defined(_CPPRTTI)
+        anonymous::VisitNestedSourceFrames<FixedContextualException>(source,
+                                                                    &copier);
+#endif
+        return exception;
+    }
+
+    // 형식 문자열 메시지를 기본 프레임 버퍼에 바로 포맷
+    template <typename... Values>
+    static FixedContextualException MakeFormatted(const SourceSite& site,
+                                                  int code,
+                                                  const char* format,
+                                                  const Values&... values) {
+        FixedContextualException exception(TextView("", 0), code, site);
+        exception.FormatBaseFrame(format, values...);
+        return exception;
+    }
+
+   public:
+    // 최초 호출 시 내부 버퍼에 렌더링
+    // (동시에 호출한 다른 스레드는 렌더링이 끝날 때까지 대기)
+    virtual const char* what() const CONTEXTUAL_EXCEPTION_NOEXCEPT override {
+        if (kWhatReady == what_state_.load(std::memory_order_acquire)) {
+            return what_;
+        }
+
+        int expected = kWhatEmpty;
+        if (what_state_.compare_exchange_strong(expected, kWhatRendering,
+                                                std::memory_order_acq_rel)) {
+            anonymous::BufferWriter writer(what_, sizeof(what_));
+            WriteFrame(&writer, BaseFrame());
+            what_state_.store(kWhatReady, std::memory_order_release);
+            return what_;
+        }
+
+        while (kWhatReady != what_state_.load(std::memory_order_acquire)) {
+            std::this_thread::yield();
+        }
+        return what_;
+    }
+
+   public:
+    const char* Message() const {
+        return BaseFrame().message;
+    }
+    int Code() const {
+        return BaseFrame().code;
+    }
+
+    const char* File() const {
+        return BaseFrame().site->file;
+    }
+    int Line() const {
+        return BaseFrame().site->line;
+    }
+    const char* Function() const {
+        return BaseFrame().site->function;
+    }
+
+    const Frame& BaseFrame() const {
+        return 0 != frame_count_ ? frames_[0] : EmptyFrame();
+    }
+    // 기본 프레임 포함 보관 중인 프레임 수
+    std::size_t FrameCount() const {
+        return frame_count_;
+    }
+    // index 0 이 기본 프레임
+    const Frame& GetFrame(std::size_t index) const {
+        return frames_[index];
+    }
+    // 용량 초과로 생략된 프레임 수 (기본 프레임 바로 아래 위치)
+    std::size_t OmittedFrames() const {
+        return omitted_frames_;
+    }
+
+    // 호환용 (std::string 할당 발생)
+    std::string DetailedErrorMessage() const {
+        const std::size_t size = WriteDetailedErrorMessage(nullptr, 0);
+        std::string detailed_error_message(size + 1, '\0');
+        WriteDetailedErrorMessage(&detailed_error_message[0], size + 1);
+        detailed_error_message.resize(size);
+        return detailed_error_message;
+    }
+    // buffer 에 NUL 종료로 기록하고 잘리지 않았다면 필요한 길이를 반환
+    // (snprintf 와 같은 규칙, 동적 할당 없음)
+    std::size_t WriteDetailedErrorMessage(char* buffer,
+                                          std::size_t capacity) const {
+        anonymous::BufferWriter writer(buffer, capacity);
+        WriteDetailedErrorMessageTo(&writer);
+        return writer.RequiredSize();
+    }
+    // 출력 스트림에 직접 기록
+    void WriteDetailedErrorMessage(std::ostream& stream) const {
+        AppendDetailedErrorMessage([&stream](const char* data,
+                                             std::size_t size) {
+            stream.write(data, static_cast<std::streamsize>(size));
+        });
+    }
+    // 조각마다 append(const char* data, std::size_t size) 호출
+    template <typename Append>
+    void AppendDetailedErrorMessage(const Append& append) const {
+        anonymous::AppendWriter<Append> writer(append);
+        WriteDetailedErrorMessageTo(&writer);
+    }
+
+   public:
+    // 새 컨텍스트 프레임을 기본 프레임으로 올림
+    // (가득 찬 경우 이전 기본 프레임을 생략)
+    void AddContext(TextView message, const SourceSite& site) {
+        const int default_code = 0;
+        AddContext(message, default_code, site);
+    }
+    void AddContext(TextView message, int code, const SourceSite& site) {
+        if (0 != frame_count_) {
+            if (MaxFrames == frame_count_) {
+                ++omitted_frames_;
+            } else {
+                std::memmove(&frames_[1], &frames_[0],
+                             sizeof(Frame) * frame_count_);
+                ++frame_count_;
+            }
+        } else {
+            frame_count_ = 1;
+        }
+        AssignFrame(&frames_[0], message, code, site);
+        what_state_.store(kWhatEmpty, std::memory_order_release);
+    }
+    // 형식 문자열 메시지를 새 기본 프레임 버퍼에 바로 포맷
+    template <typename... Values>
+    void AddFormattedContext(const SourceSite& site, int code,
+                             const char* format, const Values&... values) {
+        AddContext(TextView("", 0), code, site);
+        FormatBaseFrame(format, values...);
+    }
+
+   public:
+    // FrameSource: 기본 프레임부터 순서대로 전달
+    // - 잘린 메시지는 "..." 을 붙여 전달 (스택 버퍼, 할당 없음)
+    virtual void VisitFrames(FrameSink* sink) const override {
+        for (std::size_t ii = 0; ii < frame_count_; ++ii) {
+            const Frame& frame = frames_[ii];
+            if (frame.truncated) {
+                char message[MaxMessageBytes + 3];
+                anonymous::BufferWriter writer(message, sizeof(message));
+                writer.Append(frame.message);
+                writer.Append("...");
+                sink->AddFrame(message, frame.code, *frame.site);
+            } else {
+                sink->AddFrame(frame.message, frame.code, *frame.site);
+            }
+            if (0 == ii && 0 != omitted_frames_) {
+                sink->AddOmittedFrames(omitted_frames_);
+            }
+        }
+    }
+
+   private:
+    // FrameSource 가 전달한 프레임을 하위 프레임으로 추가
+    class FrameAppender : public FrameSink {
+       public:
+        explicit FrameAppender(FixedContextualException* exception)
+            : exception_(exception) {}
+
+        virtual void AddFrame(const char* message, int code,
+                              const SourceSite& site) override {
+            exception_->AppendChildFrame(message, code, site);
+        }
+        virtual void AddFrames(const ContextualException& exception) override {
+            exception_->WrapContextualException(exception);
+        }
+        virtual void AddOmittedFrames(std::size_t count) override {
+            exception_->omitted_frames_ += count;
+        }
+
+       private:
+        FixedContextualException* exception_;
+    };
+
+    // FrameSource 가 전달한 프레임을 기본 프레임부터 그대로 추가 (FromSource)
+    class FrameCopier : public FrameSink {
+       public:
+        explicit FrameCopier(FixedContextualException* exception)
+            : exception_(exception) {}
+
+        virtual void AddFrame(const char* message, int code,
+                              const SourceSite& site) override {
+            exception_->AppendChildFrame(message, code, site);
+        }
+        virtual void AddFrames(const ContextualException& exception) override {
+            typedef ContextualException::FrameNode FrameNode;
+            const ContextualException::Frame& base = exception.BaseFrame();
+            exception_->AppendChildFrame(base.Message(), base.code,
+                                         *base.site);
+            for (const FrameNode* node = exception.ChildFrames(); node;
+                 node = node->next.get()) {
+                exception_->AppendChildFrame(node->frame.Message(),
+                                             node->frame.code,
+                                             *node->frame.site);
+            }
+        }
+        virtual void AddOmittedFrames(std::size_t count) override {
+            exception_->omitted_frames_ += count;
+        }
+
+       private:
+        FixedContextualException* exception_;
+    };
+
+    enum { kWhatEmpty = 0, kWhatRendering = 1, kWhatReady = 2 };
+    // what() 버퍼의 위치 정보 몫 (파일명, 함수명, 라인, 코드)
+    enum { kWhatSiteBytes = 256 };
+
+    template <typename... Values>
+    void FormatBaseFrame(const char* format, const Values&... values) {
+        Frame& frame = frames_[0];
+        anonymous::BufferStreamBuffer buffer(frame.message,
+                                             sizeof(frame.message));
+        std::ostream stream(&buffer);
+        anonymous::WriteFormat(stream, format, values...);
+        frame.truncated = buffer.Writer().Truncated();
+    }
+
+    void SetBaseFrame(TextView message, int code, const SourceSite& site) {
+        AssignFrame(&frames_[0], message, code, site);
+        frame_count_ = 1;
+        anonymous::RecordSite(site, code);
+    }
+
+    // 하위 프레임이 넘치면 가장 가까운(얕은) 하위 프레임부터 생략
+    void WrapException(const std::exception& exception) {
+        const FrameSource* source = anonymous::AsFrameSource(exception);
+        if (source) {
+            WrapFrameSource(*source);
+            return;
+        }
+        WrapOtherException(exception);
+        WrapNestedException(exception);
+    }
+    void WrapFrameSource(const FrameSource& source) {
+        FrameAppender appender(this);
+        source.VisitFrames(&appender);
+#if defined(__GXX_RTTI) || defined(_CPPRTTI)
+        // std::throw_with_nested 로 던져졌으면 중첩된 예외들도 하위 프레임
+        anonymous::VisitNestedSourceFrames<FixedContextualException>(
+            source, &appender);
+#endif
+    }
+    void WrapFixedException(const FixedContextualException& exception) {
+        const std::size_t count = exception.frame_count_;
+        const std::size_t skipped = SkippedChildFrames(count);
+        omitted_frames_ += skipped + exception.omitted_frames_;
+        for (std::size_t ii = skipped; ii < count; ++ii) {
+            frames_[frame_count_++] = exception.frames_[ii];
+        }
+    }
+    void WrapContextualException(const ContextualException& exception) {
+        typedef ContextualException::FrameNode FrameNode;
+        std::size_t count = 0;
+        for (const FrameNode* node = exception.ChildFrames(); node;
+             node = node->next.get()) {
+            ++count;
+        }
+
+        const ContextualException::Frame& inner_base = exception.BaseFrame();
+        ++count;
+        const std::size_t skipped = SkippedChildFrames(count);
+        omitted_frames_ += skipped;
+
+        // skipped 개: 하위 예외의 기본 프레임부터 생략
+        const FrameNode* head = exception.ChildFrames();
+        if (0 == skipped) {
+            AppendFrame(inner_base.Message(), inner_base.code,
+                        *inner_base.site);
+        }
+        for (std::size_t ii = 1; ii < skipped; ++ii) {
+            head = head->next.get();
+        }
+        for (const FrameNode* node = head; node; node = node->next.get()) {
+            AppendFrame(node->frame.Message(), node->frame.code,
+                        *node->frame.site);
+        }
+    }
+    // std::throw_with_nested 로 중첩된 예외는 단계마다 하위 프레임
+    void WrapNestedException(const std::exception& exception) {
+#if defined(__GXX_RTTI) || defined(_CPPRTTI)
+        const std::nested_exception* nested =
+            dynamic_cast<const std::nested_exception*>(&exception);
+        if (nested) {
+            FrameAppender appender(this);
+            anonymous::VisitNestedFrames(*nested, &appender);
+        }
+#else
+        (void)exception;
+#endif
+    }
+    void WrapOtherException(const std::exception& exception) {
+        Frame& frame = frames_[0];
+        const std::size_t size = std::strlen(frame.message);
+        anonymous::BufferWriter writer(frame.message + size,
+                                       sizeof(frame.message) - size);
+        if (0 != size) {
+            writer.Append(", ");
+        }
+        writer.Append(exception.what());
+        frame.truncated = frame.truncated || writer.Truncated();
+    }
+
+    std::size_t SkippedChildFrames(std::size_t count) const {
+        const std::size_t available = MaxFrames - frame_count_;
+        return count > available ? count - available : 0;
+    }
+
+    void AppendFrame(TextView message, int code, const SourceSite& site) {
+        AssignFrame(&frames_[frame_count_++], message, code, site);
+    }
+    // 개수를 미리 알 수 없을 때: 가득 차면 가장 얕은 하위 프레임을 밀어냄
+    void AppendChildFrame(TextView message, int code, const SourceSite& site) {
+        if (MaxFrames == frame_count_) {
+            ++omitted_frames_;
+            if (1 == MaxFrames) {
+                return;
+            }
+            std::memmove(&frames_[1], &frames_[2],
+                         sizeof(Frame) * (frame_count_ - 2));
+            --frame_count_;
+        }
+        AppendFrame(message, code, site);
+    }
+
+    static void AssignFrame(Frame* frame, TextView message, int code,
+                            const SourceSite& site) {
+        frame->site = &site;
+        frame->code = code;
+        anonymous::BufferWriter writer(frame->message, sizeof(frame->message));
+        writer.Append(message.data, message.size);
+        frame->truncated = writer.Truncated();
+    }
+
+    void CopyFrom(const FixedContextualException& other) {
+        frame_count_ = other.frame_count_;
+        omitted_frames_ = other.omitted_frames_;
+        std::memcpy(frames_, other.frames_, sizeof(Frame) * frame_count_);
+        what_state_.store(kWhatEmpty, std::memory_order_relaxed);
+    }
+
+    template <typename Writer>
+    void WriteDetailedErrorMessageTo(Writer* writer) const {
+        WriteFrame(writer, BaseFrame());
+        if (0 != omitted_frames_) {
+            writer->Append("\n    ... ");
+            writer->AppendInteger(static_cast<long long>(omitted_frames_));
+            writer->Append(" frames omitted");
+        }
+        for (std::size_t ii = 1; ii < frame_count_; ++ii) {
+            writer->Append("\n    ");
+            WriteFrame(writer, frames_[ii]);
+        }
+    }
+
+    template <typename Writer>
+    static void WriteFrame(Writer* writer, const Frame& frame) {
+        anonymous::WriteFrameText(writer, *frame.site, frame.code,
+                                  frame.message);
+        if (frame.truncated) {
+            writer->Append("...");
+        }
+    }
+
+    static const Frame& EmptyFrame() {
+        static const SourceSite empty_site = {"", "", 0, nullptr};
+        static const Frame empty_frame = {&empty_site, 0, false, {'\0'}};
+        return empty_frame;
+    }
+
+   private:
+    Frame frames_[MaxFrames];
+    std::size_t frame_count_;
+    std::size_t omitted_frames_;
+
+    mutable std::atomic<int> what_state_;
+    mutable char what_[MaxMessageBytes + kWhatSiteBytes];
+};
+
+#if defined(CONTEXTUAL_EXCEPTION_USE_FIXED_CAPACITY)
+// 매크로가 생성하는 예외 타입
+typedef FixedContextualException<CONTEXTUAL_EXCEPTION_FIXED_FRAMES,
+                                 CONTEXTUAL_EXCEPTION_FIXED_MESSAGE_BYTES>
+    Exception;
+#endif
+
+namespace anonymous {
+
+template <typename Exception>
+inline Exception MakeFixed(const SourceSite& site, TextView message) {
+    return Exception(message, site);
+}
+
+template <typename Exception>
+inline Exception MakeFixed(const SourceSite& site, TextView message,
+                           int code) {
+    return Exception(message, code, site);
+}
+
+template <typename Exception, typename Source>
+inline Exception WrapFixed(const SourceSite& site, TextView message,
+                           const Source& exception) {
+    return Exception(message, exception, site);
+}
+
+template <typename Exception, typename Source>
+inline Exception WrapFixed(const SourceSite& site, TextView message, int code,
+                           const Source& exception) {
+    return Exception(message, code, exception, site);
+}
+
+template <typename Exception, int Placeholders, typename... Values>
+inline Exception MakeFixedFormatted(const SourceSite& site, int code,
+                                    const char* format,
+                                    const Values&... values) {
+    static_assert(FormatArgumentsCheck<Placeholders, sizeof...(Values)>::value,
+                  "invalid format arguments");
+    return Exception::MakeFormatted(site, code, format, values...);
+}
+
+template <std::size_t MaxFrames, std::size_t MaxMessageBytes>
+inline FixedContextualException<MaxFrames, MaxMessageBytes>* SafeChain(
+    const SourceSite& site, TextView message,
+    FixedContextualException<MaxFrames, MaxMessageBytes>*
+        source_exception_or_null) {
+    if (!source_exception_or_null) {
+        return nullptr;
+    }
+
+    source_exception_or_null->AddContext(message, site);
+
+    return source_exception_or_null;
+}
+
+template <std::size_t MaxFrames, std::size_t MaxMessageBytes>
+inline FixedContextualException<MaxFrames, MaxMessageBytes>* SafeChain(
+    const SourceSite& site, TextView message, int code,
+    FixedContextualException<MaxFrames, MaxMessageBytes>*
+        source_exception_or_null) {
+    if (!source_exception_or_null) {
+        return nullptr;
+    }
+
+    source_exception_or_null->AddContext(message, code, site);
+
+    return source_exception_or_null;
+}
+
+template <std::size_t MaxFrames, std::size_t MaxMessageBytes>
+inline FixedContextualException<MaxFrames, MaxMessageBytes>& AddContext(
+    FixedContextualException<MaxFrames, MaxMessageBytes>& exception,
+    const SourceSite& site, TextView message) {
+    exception.AddContext(message, site);
+    return exception;
+}
+
+template <std::size_t MaxFrames, std::size_t MaxMessageBytes>
+inline FixedContextualException<MaxFrames, MaxMessageBytes>& AddContext(
+    FixedContextualException<MaxFrames, MaxMessageBytes>& exception,
+    const SourceSite& site, TextView message, int code) {
+    exception.AddContext(message, code, site);
+    return exception;
+}
+
+}  // namespace anonymous
+}  // namespace contextual_exception
+
+#endif  //__FIXED_CONTEXTUAL_EXCEPTION_HPP__
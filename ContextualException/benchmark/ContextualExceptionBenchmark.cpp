@@ -0,0 +1,548 @@
+// ContextualException 성능 측정
+//
+// 빌드 예)
+//   g++ -std=c++17 -O2 -pthread ContextualExceptionBenchmark.cpp -o benchmark
+//   (고정 용량 모드: -DCONTEXTUAL_EXCEPTION_USE_FIXED_CAPACITY)
+// 공유 라이브러리 경계 항목 포함 (*_shared)
+//   g++ -std=c++17 -O2 -fPIC -shared -fvisibility=hidden
+//       FrameSourceLibrary.cpp -o libframesource.so
+//   g++ -std=c++17 -O2 -pthread -DBENCHMARK_FRAME_SOURCE_LIBRARY
+//       ContextualExceptionBenchmark.cpp -L. -lframesource
+//       -Wl,-rpath,'$ORIGIN' -o benchmark
+// 실행 예)
+//   ./benchmark            전체 실행
+//   ./benchmark wrap       이름에 "wrap" 이 포함된 항목만 실행
+//
+// 출력: 항목당 JSON 한 줄 (JSON Lines)
+//   {"benchmark":"throw_catch","param":8,"mode":"dynamic","iterations":...,
+//    "ns_per_op":...,"allocs_per_op":...,"bytes_per_op":...}
+// - 할당 횟수/바이트는 전역 operator new 기준
+//   (throw 된 예외 객체 자체는 __cxa_allocate_exception 이 할당하므로 제외)
+// - 각 항목은 3회 측정 중 가장 빠른 값
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../ContextualException.hpp"
+#include "../ContextualResult.hpp"
+#include "../ContextualStructuredLog.hpp"
+
+#if defined(BENCHMARK_FRAME_SOURCE_LIBRARY)
+// FrameSourceLibrary.cpp (kind 0: FrameSource 아님, 1: Exception)
+extern "C" const std::exception* LibraryException(int kind);
+#endif
+
+#if defined(__GNUC__)
+#define BENCHMARK_NOINLINE __attribute__((noinline))
+#elif defined(_MSC_VER)
+#define BENCHMARK_NOINLINE __declspec(noinline)
+#else
+#define BENCHMARK_NOINLINE
+#endif
+
+namespace {
+
+std::atomic<unsigned long long> allocation_count(0);
+std::atomic<unsigned long long> allocation_bytes(0);
+
+}  // namespace
+
+// 할당 횟수 계측용 전역 operator new/delete 교체
+// (호출 지점에 인라인되면 new/free 짝 불일치 경고가 나므로 noinline)
+BENCHMARK_NOINLINE void* operator new(std::size_t size) {
+    allocation_count.fetch_add(1, std::memory_order_relaxed);
+    allocation_bytes.fetch_add(size, std::memory_order_relaxed);
+    void* pointer = std::malloc(0 != size ? size : 1);
+    if (!pointer) {
+        throw std::bad_alloc();
+    }
+    return pointer;
+}
+BENCHMARK_NOINLINE void* operator new[](std::size_t size) {
+    return operator new(size);
+}
+BENCHMARK_NOINLINE void operator delete(void* pointer)
+    CONTEXTUAL_EXCEPTION_NOEXCEPT {
+    std::free(pointer);
+}
+BENCHMARK_NOINLINE void operator delete[](void* pointer)
+    CONTEXTUAL_EXCEPTION_NOEXCEPT {
+    std::free(pointer);
+}
+BENCHMARK_NOINLINE void operator delete(void* pointer, std::size_t)
+    CONTEXTUAL_EXCEPTION_NOEXCEPT {
+    std::free(pointer);
+}
+BENCHMARK_NOINLINE void operator delete[](void* pointer, std::size_t)
+    CONTEXTUAL_EXCEPTION_NOEXCEPT {
+    std::free(pointer);
+}
+
+namespace {
+
+typedef contextual_exception::Exception Exception;
+
+#if defined(CONTEXTUAL_EXCEPTION_USE_FIXED_CAPACITY)
+const char* const kMode = "fixed";
+#else
+const char* const kMode = "dynamic";
+#endif
+
+// 측정 대상 결과를 컴파일러가 제거하지 못하도록 사용 처리
+template <typename Value>
+inline void DoNotOptimize(const Value& value) {
+#if defined(__GNUC__)
+    asm volatile("" : : "g"(&value) : "memory");
+#else
+    static volatile const void* sink;
+    sink = &value;
+#endif
+}
+
+struct Measurement {
+    unsigned long long iterations;
+    double nanoseconds;
+    unsigned long long allocations;
+    unsigned long long bytes;
+};
+
+class Stopwatch {
+   public:
+    void Start() {
+        allocations_ = allocation_count.load(std::memory_order_relaxed);
+        bytes_ = allocation_bytes.load(std::memory_order_relaxed);
+        start_ = std::chrono::steady_clock::now();
+    }
+    void Stop(Measurement* measurement) {
+        const auto stop = std::chrono::steady_clock::now();
+        measurement->nanoseconds +=
+            std::chrono::duration<double, std::nano>(stop - start_).count();
+        measurement->allocations +=
+            allocation_count.load(std::memory_order_relaxed) - allocations_;
+        measurement->bytes +=
+            allocation_bytes.load(std::memory_order_relaxed) - bytes_;
+    }
+
+   private:
+    std::chrono::steady_clock::time_point start_;
+    unsigned long long allocations_;
+    unsigned long long bytes_;
+};
+
+const char* filter = nullptr;
+const double kMinimumNanoseconds = 50e6;
+const int kRepetitions = 3;
+
+void Report(const char* name, int param, const Measurement& measurement) {
+    const double iterations = static_cast<double>(measurement.iterations);
+    std::printf(
+        "{\"benchmark\":\"%s\",\"param\":%d,\"mode\":\"%s\","
+        "\"iterations\":%llu,\"ns_per_op\":%.2f,\"allocs_per_op\":%.2f,"
+        "\"bytes_per_op\":%.1f}\n",
+        name, param, kMode, measurement.iterations,
+        measurement.nanoseconds / iterations,
+        static_cast<double>(measurement.allocations) / iterations,
+        static_cast<double>(measurement.bytes) / iterations);
+    std::fflush(stdout);
+}
+
+// run(iterations, stopwatch, measurement): iterations 회 수행하며 측정 구간만
+// stopwatch 로 감쌈 (준비 작업은 측정에서 제외)
+template <typename Run>
+void Benchmark(const char* name, int param, Run run) {
+    if (filter && !std::strstr(name, filter)) {
+        return;
+    }
+
+    unsigned long long iterations = 1;
+    Measurement best = {0, 0, 0, 0};
+    for (int repetition = 0; repetition < kRepetitions;) {
+        Measurement measurement = {iterations, 0, 0, 0};
+        Stopwatch stopwatch;
+        run(iterations, &stopwatch, &measurement);
+        if (measurement.nanoseconds < kMinimumNanoseconds) {
+            iterations *= measurement.nanoseconds < kMinimumNanoseconds / 10
+                              ? 10
+                              : 2;
+            continue;
+        }
+        if (0 == repetition ||
+            measurement.nanoseconds / measurement.iterations <
+                best.nanoseconds / best.iterations) {
+            best = measurement;
+        }
+        ++repetition;
+    }
+    Report(name, param, best);
+}
+
+// 준비된 batch 에 대해 operation 만 측정
+const std::size_t kBatchSize = 256;
+
+template <typename Setup, typename Operation>
+void BatchBenchmark(const char* name, int param, Setup setup,
+                    Operation operation) {
+    Benchmark(name, param,
+              [&](unsigned long long iterations, Stopwatch* stopwatch,
+                  Measurement* measurement) {
+                  std::vector<Exception> batch;
+                  batch.reserve(kBatchSize);
+                  for (unsigned long long done = 0; done < iterations;) {
+                      const std::size_t count = static_cast<std::size_t>(
+                          std::min<unsigned long long>(kBatchSize,
+                                                       iterations - done));
+                      batch.clear();
+                      for (std::size_t ii = 0; ii < count; ++ii) {
+                          batch.push_back(setup());
+                      }
+                      stopwatch->Start();
+                      for (std::size_t ii = 0; ii < count; ++ii) {
+                          operation(batch[ii]);
+                      }
+                      stopwatch->Stop(measurement);
+                      done += count;
+                  }
+              });
+}
+
+// 측정 구간 안에서 매번 예외를 만들고 없애는 항목용
+template <typename Operation>
+void SimpleBenchmark(const char* name, int param, Operation operation) {
+    Benchmark(name, param,
+              [&](unsigned long long iterations, Stopwatch* stopwatch,
+                  Measurement* measurement) {
+                  stopwatch->Start();
+                  for (unsigned long long ii = 0; ii < iterations; ++ii) {
+                      operation(static_cast<int>(ii));
+                  }
+                  stopwatch->Stop(measurement);
+              });
+}
+
+// depth 번째 호출에서 throw (value 가 음수이면 성공)
+BENCHMARK_NOINLINE int ThrowAtDepth(int depth, int value) {
+    if (depth > 1) {
+        int result = ThrowAtDepth(depth - 1, value);
+        DoNotOptimize(result);
+        return result + 1;
+    }
+    if (value >= 0) {
+        THROW_CONTEXTUAL_EXCEPTION("benchmark failure", value);
+    }
+    return value;
+}
+
+// 각 단계에서 catch 후 컨텍스트를 추가해 다시 throw
+BENCHMARK_NOINLINE int ThrowWithContextAtDepth(int depth, int value) {
+    if (depth > 1) {
+        try {
+            int result = ThrowWithContextAtDepth(depth - 1, value);
+            DoNotOptimize(result);
+            return result + 1;
+        } catch (Exception& exception) {
+            ADD_CONTEXT_TO_CONTEXTUAL_EXCEPTION(exception, "");
+            throw;
+        }
+    }
+    if (value >= 0) {
+        THROW_CONTEXTUAL_EXCEPTION("benchmark failure", value);
+    }
+    return value;
+}
+
+// ThrowWithContextAtDepth 의 CONTEXTUAL_SCOPE 버전 (catch, 재throw 없음)
+BENCHMARK_NOINLINE int ThrowInScopeAtDepth(int depth, int value) {
+    CONTEXTUAL_SCOPE("depth {}", depth);
+    if (depth > 1) {
+        int result = ThrowInScopeAtDepth(depth - 1, value);
+        DoNotOptimize(result);
+        return result + 1;
+    }
+    if (value >= 0) {
+        THROW_CONTEXTUAL_EXCEPTION("benchmark failure", value);
+    }
+    return value;
+}
+
+// ThrowWithContextAtDepth 의 Result 버전 (각 단계에서 CONTEXTUAL_TRY)
+// (value 가 음수이면 성공)
+BENCHMARK_NOINLINE contextual_exception::Result<int> ErrorAtDepth(int depth,
+                                                                   int value) {
+    if (depth <= 1) {
+        if (value >= 0) {
+            return CONTEXTUAL_ERROR("benchmark failure", value);
+        }
+        return value;
+    }
+    CONTEXTUAL_TRY_ASSIGN(int result, ErrorAtDepth(depth - 1, value), "");
+    DoNotOptimize(result);
+    return result + 1;
+}
+
+Exception MakeWrapChain(int length) {
+    Exception exception = CONTEXTUAL_EXCEPTION("benchmark base", 1);
+    for (int ii = 1; ii < length; ++ii) {
+        exception = WRAP_CONTEXTUAL_EXCEPTION("benchmark context", ii,
+                                              std::move(exception));
+    }
+    return exception;
+}
+
+Exception MakeSafeChain(int length) {
+    Exception exception = CONTEXTUAL_EXCEPTION("benchmark base", 1);
+    Exception* pointer = &exception;
+    for (int ii = 1; ii < length; ++ii) {
+        SAFE_CHAIN_CONTEXTUAL_EXCEPTION_TO("benchmark context", ii, pointer);
+    }
+    return exception;
+}
+
+// std::throw_with_nested 로 length 단계 중첩된 예외
+std::exception_ptr MakeNestedChain(int length) {
+    std::exception_ptr nested;
+    for (int ii = 0; ii < length; ++ii) {
+        try {
+            if (!nested) {
+                throw std::runtime_error("benchmark base");
+            }
+            try {
+                std::rethrow_exception(nested);
+            } catch (...) {
+                std::throw_with_nested(std::runtime_error("benchmark context"));
+            }
+        } catch (...) {
+            nested = std::current_exception();
+        }
+    }
+    return nested;
+}
+
+void FrameSourceBenchmark(const char* cached_name, const char* cast_name,
+                          int param, const std::exception* target) {
+    SimpleBenchmark(cached_name, param, [target](int) {
+        DoNotOptimize(target);
+        const contextual_exception::FrameSource* source =
+            contextual_exception::anonymous::AsFrameSource(*target);
+        DoNotOptimize(source);
+    });
+    SimpleBenchmark(cast_name, param, [target](int) {
+        DoNotOptimize(target);
+        const contextual_exception::FrameSource* source =
+            dynamic_cast<const contextual_exception::FrameSource*>(target);
+        DoNotOptimize(source);
+    });
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    if (argc > 1) {
+        filter = argv[1];
+    }
+
+    // libstdc++ 는 스레드를 만든 적 없는 프로세스에서 shared_ptr 참조 카운트를
+    // 원자적 연산 없이 처리하므로, 실제 서비스와 같은 조건으로 맞춤
+    std::thread([] {}).join();
+
+    static const int kDepths[] = {1, 8, 64};
+    static const int kLengths[] = {1, 8, 64};
+
+    SimpleBenchmark("construct", 0, [](int ii) {
+        Exception exception = CONTEXTUAL_EXCEPTION("benchmark failure", ii);
+        DoNotOptimize(exception);
+    });
+    SimpleBenchmark("construct_formatted", 0, [](int ii) {
+        Exception exception =
+            CONTEXTUAL_EXCEPTION_F("benchmark failure {} of {}", ii, 64);
+        DoNotOptimize(exception);
+    });
+    SimpleBenchmark("construct_and_throw", 0, [](int ii) {
+        try {
+            THROW_CONTEXTUAL_EXCEPTION("benchmark failure", ii);
+        } catch (const Exception& exception) {
+            DoNotOptimize(exception);
+        }
+    });
+
+    for (int depth : kDepths) {
+        SimpleBenchmark("throw_catch", depth, [depth](int ii) {
+            try {
+                DoNotOptimize(ThrowAtDepth(depth, ii));
+            } catch (const Exception& exception) {
+                DoNotOptimize(exception);
+            }
+        });
+    }
+    // 같은 깊이에서 실패 없이 값 반환 (try 블록과 호출 비용만)
+    for (int depth : kDepths) {
+        SimpleBenchmark("throw_catch_ok", depth, [depth](int ii) {
+            try {
+                DoNotOptimize(ThrowAtDepth(depth, ~ii));
+            } catch (const Exception& exception) {
+                DoNotOptimize(exception);
+            }
+        });
+    }
+    for (int depth : kDepths) {
+        SimpleBenchmark("throw_add_context", depth, [depth](int ii) {
+            try {
+                DoNotOptimize(ThrowWithContextAtDepth(depth, ii));
+            } catch (const Exception& exception) {
+                DoNotOptimize(exception);
+            }
+        });
+    }
+    for (int depth : kDepths) {
+        SimpleBenchmark("throw_in_scope", depth, [depth](int ii) {
+            try {
+                DoNotOptimize(ThrowInScopeAtDepth(depth, ii));
+            } catch (const Exception& exception) {
+                DoNotOptimize(exception);
+            }
+        });
+    }
+    // 실패 없이 범위만 진입, 해제
+    SimpleBenchmark("scope_enter_leave", 0, [](int ii) {
+        CONTEXTUAL_SCOPE("iteration {}", ii);
+        DoNotOptimize(ii);
+    });
+    for (int depth : kDepths) {
+        SimpleBenchmark("result_propagate", depth, [depth](int ii) {
+            contextual_exception::Result<int> result = ErrorAtDepth(depth, ii);
+            DoNotOptimize(result);
+        });
+    }
+    for (int depth : kDepths) {
+        SimpleBenchmark("result_propagate_ok", depth, [depth](int ii) {
+            contextual_exception::Result<int> result =
+                ErrorAtDepth(depth, ~ii);
+            DoNotOptimize(result);
+        });
+    }
+
+    for (int length : kLengths) {
+        SimpleBenchmark("wrap_chain", length, [length](int) {
+            Exception exception = MakeWrapChain(length);
+            DoNotOptimize(exception);
+        });
+    }
+    for (int length : kLengths) {
+        SimpleBenchmark("safe_chain", length, [length](int) {
+            Exception exception = MakeSafeChain(length);
+            DoNotOptimize(exception);
+        });
+    }
+
+    // 중첩 단계마다 하위 프레임 1개
+    for (int length : kLengths) {
+        try {
+            std::rethrow_exception(MakeNestedChain(length));
+        } catch (const std::exception& nested) {
+            SimpleBenchmark("wrap_nested", length, [&nested](int) {
+                Exception exception =
+                    WRAP_CONTEXTUAL_EXCEPTION("benchmark context", nested);
+                DoNotOptimize(exception);
+            });
+        }
+    }
+
+    // std::exception 으로만 아는 예외의 FrameSource 확인
+    // (param 0: std::runtime_error, 1: Exception)
+    // - as_frame_source: 최종 파생 타입의 type_info 주소별로 결과 캐시
+    // - dynamic_cast_frame_source: 매번 dynamic_cast
+    // - *_shared: 공유 라이브러리에서 정의, 생성한 예외 (type_info 가 실행
+    //   파일과 별도이면 dynamic_cast 에 이름 비교가 더해짐)
+    {
+        const std::runtime_error runtime_error("benchmark failure");
+        const Exception exception = CONTEXTUAL_EXCEPTION("benchmark failure");
+        const std::exception* const exceptions[] = {&runtime_error,
+                                                    &exception};
+        for (int param = 0; param < 2; ++param) {
+            FrameSourceBenchmark("as_frame_source",
+                                 "dynamic_cast_frame_source", param,
+                                 exceptions[param]);
+        }
+#if defined(BENCHMARK_FRAME_SOURCE_LIBRARY)
+        for (int param = 0; param < 2; ++param) {
+            FrameSourceBenchmark("as_frame_source_shared",
+                                 "dynamic_cast_frame_source_shared", param,
+                                 LibraryException(param));
+        }
+#endif
+    }
+
+    for (int length : kLengths) {
+        BatchBenchmark(
+            "what_first", length, [length] { return MakeWrapChain(length); },
+            [](const Exception& exception) {
+                const char* what = exception.what();
+                DoNotOptimize(what);
+            });
+    }
+    // 이하 항목은 결과가 바뀌지 않으므로 미리 만든 예외 하나를 반복 사용
+    for (int length : kLengths) {
+        const Exception exception = MakeWrapChain(length);
+        exception.what();
+        SimpleBenchmark("what_cached", length, [&exception](int) {
+            const char* what = exception.what();
+            DoNotOptimize(what);
+        });
+    }
+    for (int length : kLengths) {
+        const Exception exception = MakeWrapChain(length);
+        SimpleBenchmark("detailed_error_message", length, [&exception](int) {
+            std::string detailed = exception.DetailedErrorMessage();
+            DoNotOptimize(detailed);
+        });
+    }
+    // 로그 한 줄마다 같은 버퍼를 비우고 재사용
+    for (int length : kLengths) {
+        const Exception exception = MakeWrapChain(length);
+        std::string line;
+        SimpleBenchmark("frames_json", length, [&exception, &line](int) {
+            line.clear();
+            contextual_exception::AppendFramesJson(exception, &line);
+            DoNotOptimize(line);
+        });
+    }
+    for (int length : kLengths) {
+        const Exception exception = MakeWrapChain(length);
+        std::string line;
+        SimpleBenchmark("frames_logfmt", length, [&exception, &line](int) {
+            line.clear();
+            contextual_exception::AppendFramesLogfmt(exception, &line);
+            DoNotOptimize(line);
+        });
+    }
+
+    // what() 이 렌더링되기 전의 복사
+    for (int length : kLengths) {
+        const Exception exception = MakeWrapChain(length);
+        SimpleBenchmark("copy", length, [&exception](int) {
+            Exception copy(exception);
+            DoNotOptimize(copy);
+        });
+    }
+    // what() 이 렌더링된 뒤의 복사 (throw, exception_ptr 보관 등)
+    for (int length : kLengths) {
+        const Exception exception = MakeWrapChain(length);
+        exception.what();
+        SimpleBenchmark("copy_rendered", length, [&exception](int) {
+            Exception copy(exception);
+            DoNotOptimize(copy);
+        });
+    }
+
+    return 0;
+}
@@ -0,0 +1,37 @@
+// ContextualExceptionBenchmark 의 공유 라이브러리 경계 측정용 예외
+// - 실행 파일과 별도로 빌드해 링크 (ContextualExceptionBenchmark.cpp 참고)
+// - -fvisibility=hidden 으로 빌드하면 type_info 가 실행 파일의 것과 별도
+//   (dynamic_cast 가 type_info 이름 비교로 진행)
+
+#include <exception>
+#include <stdexcept>
+
+#include "../ContextualException.hpp"
+
+#if defined(_WIN32)
+#define FRAME_SOURCE_LIBRARY_EXPORT __declspec(dllexport)
+#else
+#define FRAME_SOURCE_LIBRARY_EXPORT __attribute__((visibility("default")))
+#endif
+
+namespace {
+
+// 라이브러리가 정의한 예외 (FrameSource 아님)
+class LibraryError : public std::runtime_error {
+   public:
+    explicit LibraryError(const char* message) : std::runtime_error(message) {}
+};
+
+}  // namespace
+
+// kind 0: LibraryError, 1: 라이브러리에서 만든 Exception
+extern "C" FRAME_SOURCE_LIBRARY_EXPORT const std::exception*
+LibraryException(int kind) {
+    static const LibraryError error("benchmark failure");
+    static const contextual_exception::Exception exception =
+        CONTEXTUAL_EXCEPTION("benchmark failure");
+    if (0 == kind) {
+        return &error;
+    }
+    return &exception;
+}
@@ -0,0 +1,49 @@
+// THROW_* 호출 지점의 코드 크기 측정용 표본
+// - 검사 함수 200개, 함수마다 throw 지점 2개
+// - 컴파일만 하고 섹션 크기를 비교 (ThrowSiteCodeSize.sh)
+
+#include "../ContextualException.hpp"
+
+#define VALIDATOR(index)                                              \
+    int Check##index(int value) {                                     \
+        if (value == index) {                                         \
+            THROW_CONTEXTUAL_EXCEPTION("value out of range", index);  \
+        }                                                             \
+        if (value < -index) {                                         \
+            THROW_CONTEXTUAL_EXCEPTION("negative value for " #index); \
+        }                                                             \
+        return value + index;                                         \
+    }
+#define VALIDATORS(prefix) \
+    VALIDATOR(prefix##0)   \
+    VALIDATOR(prefix##1)   \
+    VALIDATOR(prefix##2)   \
+    VALIDATOR(prefix##3)   \
+    VALIDATOR(prefix##4)   \
+    VALIDATOR(prefix##5)   \
+    VALIDATOR(prefix##6)   \
+    VALIDATOR(prefix##7)   \
+    VALIDATOR(prefix##8)   \
+    VALIDATOR(prefix##9)
+
+VALIDATORS(1)
+VALIDATORS(2)
+VALIDATORS(3)
+VALIDATORS(4)
+VALIDATORS(5)
+VALIDATORS(6)
+VALIDATORS(7)
+VALIDATORS(8)
+VALIDATORS(9)
+VALIDATORS(10)
+VALIDATORS(11)
+VALIDATORS(12)
+VALIDATORS(13)
+VALIDATORS(14)
+VALIDATORS(15)
+VALIDATORS(16)
+VALIDATORS(17)
+VALIDATORS(18)
+VALIDATORS(19)
+VALIDATORS(20)
+
@@ -0,0 +1,50 @@
+#!/bin/sh
+# THROW_* 호출 지점의 코드 크기 비교
+# 사용 예)
+#   ./ThrowSiteCodeSize.sh                 현재 헤더
+#   ./ThrowSiteCodeSize.sh baseline HEAD   git 리비전의 헤더와 비교
+# 환경 변수: CXX (기본 g++), CXXFLAGS (기본 -std=c++17 -O2)
+set -e
+
+CXX=${CXX:-g++}
+CXXFLAGS=${CXXFLAGS:--std=c++17 -O2}
+BENCHMARK_DIR=$(cd "$(dirname "$0")" && pwd)
+WORK_DIR=$(mktemp -d)
+trap 'rm -rf "$WORK_DIR"' EXIT
+
+# $1: 이름, $2: 표본이 들어 있는 benchmark 디렉터리
+measure() {
+    $CXX $CXXFLAGS -c "$2/ThrowSiteCodeSize.cpp" -o "$WORK_DIR/sample.o"
+    size -A "$WORK_DIR/sample.o" | awk -v name="$1" '
+        $1 == ".text" { text = $2 }
+        $1 ~ /^\.text/ { all += $2 }
+        $1 == "Total" { total = $2 }
+        END {
+            printf "%-12s .text %7d  .text.* %7d  total %7d\n",
+                   name, text, all, total
+        }'
+}
+
+if [ $# -eq 0 ]; then
+    measure current "$BENCHMARK_DIR"
+    exit 0
+fi
+
+# 표본은 현재 것을 쓰고 헤더만 리비전별로 교체
+TOP=$(git -C "$BENCHMARK_DIR" rev-parse --show-toplevel)
+HEADER_DIR=$(git -C "$BENCHMARK_DIR" rev-parse --show-prefix)
+HEADER_DIR=${HEADER_DIR%/}
+HEADER_DIR=${HEADER_DIR%/*}
+for revision in "$@"; do
+    ROOT="$WORK_DIR/$revision"
+    mkdir -p "$ROOT/benchmark"
+    for header in $(git -C "$TOP" ls-tree --name-only "$revision" \
+                        "$HEADER_DIR/"); do
+        case "$header" in
+            *.hpp) git -C "$TOP" show "$revision:$header" \
+                       > "$ROOT/$(basename "$header")" ;;
+        esac
+    done
+    cp "$BENCHMARK_DIR/ThrowSiteCodeSize.cpp" "$ROOT/benchmark/"
+    measure "$revision" "$ROOT/benchmark"
+done
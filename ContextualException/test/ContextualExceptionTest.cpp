@@ -0,0 +1,282 @@
+// ContextualException 동작 검사
+//
+// 빌드, 실행은 RunTests.sh 참고 (ASan/UBSan, 고정 용량 모드, TSan)
+// 실행 예)
+//   ./test            전체 실행
+//   ./test wire       이름에 "wire" 가 포함된 항목만 실행
+//
+// 출력: 실패한 검사마다 "file:line: 조건" 한 줄, 항목마다 결과 한 줄
+// (실패가 있으면 종료 코드 1)
+
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <future>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "../ContextualAggregate.hpp"
+#include "../ContextualException.hpp"
+#include "../ContextualHop.hpp"
+#include "../ContextualResult.hpp"
+#include "../ContextualStructuredLog.hpp"
+#include "../ContextualWireFormat.hpp"
+#include "../FixedContextualException.hpp"
+
+namespace {
+
+using contextual_exception::Exception;
+using contextual_exception::Result;
+using contextual_exception::SourceSite;
+
+int failure_count = 0;
+
+#define EXPECT(condition)                                                \
+    do {                                                                 \
+        if (!(condition)) {                                              \
+            std::printf("%s:%d: %s\n", __FILE__, __LINE__, #condition); \
+            ++failure_count;                                             \
+        }                                                                \
+    } while (0)
+
+std::size_t CountText(const std::string& text, const char* needle) {
+    std::size_t count = 0;
+    for (std::size_t position = text.find(needle);
+         std::string::npos != position;
+         position = text.find(needle, position + 1)) {
+        ++count;
+    }
+    return count;
+}
+
+std::string EncodeChain() {
+    const Exception inner = CONTEXTUAL_EXCEPTION("shard 3 timeout", 110);
+    const Exception outer =
+        WRAP_CONTEXTUAL_EXCEPTION("query failed", 5, inner);
+    std::string payload;
+    contextual_exception::EncodeFrames(outer, &payload);
+    return payload;
+}
+
+void TestWireRoundTrip() {
+    const Exception inner = CONTEXTUAL_EXCEPTION("shard 3 timeout", 110);
+    const Exception outer =
+        WRAP_CONTEXTUAL_EXCEPTION("query failed", 5, inner);
+    std::string payload;
+    contextual_exception::EncodeFrames(outer, &payload);
+
+    ContextualException decoded;
+    EXPECT(contextual_exception::DecodeFrames(payload.data(), payload.size(),
+                                              &decoded));
+    EXPECT(outer.DetailedErrorMessage() == decoded.DetailedErrorMessage());
+    EXPECT(5 == decoded.Code());
+    EXPECT(std::string(outer.File()) == decoded.File());
+    EXPECT(outer.Line() == decoded.Line());
+
+    // 다시 직렬화해도 같은 바이트
+    std::string encoded_again;
+    contextual_exception::EncodeFrames(decoded, &encoded_again);
+    EXPECT(payload == encoded_again);
+}
+
+void TestWireRejectsTruncated() {
+    const std::string payload = EncodeChain();
+    ContextualException decoded;
+    for (std::size_t size = 0; size < payload.size(); ++size) {
+        EXPECT(!contextual_exception::DecodeFrames(payload.data(), size,
+                                                   &decoded));
+    }
+    const std::string trailing = payload + '\0';
+    EXPECT(!contextual_exception::DecodeFrames(trailing.data(),
+                                               trailing.size(), &decoded));
+    std::string other_version = payload;
+    other_version[2] = static_cast<char>(contextual_exception::
+                                             kWireFormatVersion + 1);
+    EXPECT(!contextual_exception::DecodeFrames(
+        other_version.data(), other_version.size(), &decoded));
+    // 실패한 복원은 exception 을 바꾸지 않음
+    EXPECT(decoded.DetailedErrorMessage().empty());
+}
+
+void TestWireBoundsDecodedSites() {
+    // 한 번도 등록되지 않은 위치
+    static const SourceSite remote_site = {"remote.cpp", "Remote", 7, nullptr};
+    const ContextualException remote("lost", 2, remote_site);
+    std::string payload;
+    contextual_exception::EncodeFrames(remote, &payload);
+
+    ContextualException decoded;
+    const std::size_t no_new_sites = 0;
+    EXPECT(contextual_exception::DecodeFrames(payload.data(), payload.size(),
+                                              &decoded, no_new_sites));
+    EXPECT(2 == decoded.Code());
+    EXPECT(0 == decoded.Line());
+    EXPECT(std::string("remote.cpp:7 | Remote() | lost") ==
+           decoded.Message());
+}
+
+void TestFixedUtf8Truncation() {
+    typedef contextual_exception::FixedContextualException<2, 8> Small;
+    static const SourceSite site = {"fixed.cpp", "Test", 1, nullptr};
+
+    // 3바이트 문자 3개 (9바이트) 는 7바이트 용량에서 2개만 남음
+    const Small exception("\xea\xb0\x80\xeb\x82\x98\xeb\x8b\xa4", site);
+    EXPECT(std::string("\xea\xb0\x80\xeb\x82\x98") == exception.Message());
+    EXPECT(exception.BaseFrame().truncated);
+
+    const Small fits("abcdefg", site);
+    EXPECT(std::string("abcdefg") == fits.Message());
+    EXPECT(!fits.BaseFrame().truncated);
+
+    // 넘치는 프레임은 기본 프레임 바로 아래에서 생략
+    const ContextualException inner("inner", site);
+    const ContextualException middle("middle", inner, site);
+    const Small outer("outer", middle, site);
+    EXPECT(2 == outer.FrameCount());
+    EXPECT(1 == outer.OmittedFrames());
+    EXPECT(std::string("inner") == outer.GetFrame(1).message);
+}
+
+Result<void> Flush(bool fail) {
+    if (fail) {
+        return CONTEXTUAL_ERROR("disk full", 28);
+    }
+    return {};
+}
+
+Result<void> Save(bool fail) {
+    CONTEXTUAL_TRY(Flush(fail), "save {}", "a.txt");
+    return {};
+}
+
+void TestResultVoidPropagation() {
+    EXPECT(Save(false).has_value());
+
+    const Result<void> failed = Save(true);
+    EXPECT(!failed.has_value());
+    // CONTEXTUAL_TRY 의 프레임은 code 0, 원래 오류의 code 는 하위 프레임에
+    EXPECT(0 == failed.error().Code());
+    EXPECT(std::string("save a.txt") == failed.error().Message());
+    const std::string detail = failed.error().DetailedErrorMessage();
+    EXPECT(1 == CountText(detail, "[code=28] disk full"));
+    EXPECT(1 == CountText(detail, "\n"));
+
+    contextual_exception::ValueOrThrow(Save(false));
+    bool thrown = false;
+    try {
+        contextual_exception::ValueOrThrow(failed);
+    } catch (const Exception& exception) {
+        thrown = true;
+        EXPECT(exception.DetailedErrorMessage() == detail);
+    }
+    EXPECT(thrown);
+}
+
+// shared_future 하나의 예외를 여러 작업이 동시에 다시 던지며 hop 추가
+// (TSan 빌드에서 경합 검사)
+void TestHopSharedConsumers() {
+    std::shared_future<int> shared =
+        std::async(std::launch::async, []() -> int {
+            throw CONTEXTUAL_EXCEPTION("load failed", 5);
+        }).share();
+    shared.wait();
+
+    const int kConsumers = 4;
+    std::vector<std::future<int>> consumers;
+    for (int ii = 0; ii < kConsumers; ++ii) {
+        consumers.push_back(std::async(
+            std::launch::async,
+            CONTEXTUAL_HOP_TASK("pool", [shared] { return shared.get(); })));
+    }
+    for (std::future<int>& consumer : consumers) {
+        bool thrown = false;
+        try {
+            consumer.get();
+        } catch (const Exception& exception) {
+            thrown = true;
+            const std::string detail = exception.DetailedErrorMessage();
+            EXPECT(5 == exception.Code());
+            EXPECT(1 == CountText(detail, "hop executor=pool"));
+            EXPECT(1 == CountText(detail, "load failed"));
+        }
+        EXPECT(thrown);
+    }
+
+    // 공유된 원본에는 hop 이 붙지 않음
+    try {
+        shared.get();
+    } catch (const Exception& exception) {
+        EXPECT(0 == CountText(exception.DetailedErrorMessage(), "hop"));
+    }
+}
+
+void TestNestedFramesInWriters() {
+    try {
+        try {
+            throw std::runtime_error("socket closed");
+        } catch (const std::exception&) {
+            std::throw_with_nested(CONTEXTUAL_EXCEPTION("send failed", 4));
+        }
+    } catch (const Exception& exception) {
+        std::string json;
+        contextual_exception::AppendFramesJson(exception, &json);
+        EXPECT(1 == CountText(json, "\"message\":\"socket closed\""));
+
+        std::string payload;
+        contextual_exception::EncodeFrames(exception, &payload);
+        ContextualException decoded;
+        EXPECT(contextual_exception::DecodeFrames(payload.data(),
+                                                  payload.size(), &decoded));
+        EXPECT(1 == CountText(decoded.DetailedErrorMessage(),
+                              "socket closed"));
+    }
+}
+
+void TestCollectorTally() {
+    static const SourceSite site = {"collector.cpp", "Test", 1, nullptr};
+    const std::size_t keep_first = 1;
+    contextual_exception::ExceptionCollector collector(keep_first);
+    collector.Add(std::runtime_error("first"));
+    collector.Add(ContextualException("second", 3, site));
+
+    const ContextualException materialized = collector.Materialize(site);
+    const std::string detail = materialized.DetailedErrorMessage();
+    EXPECT(std::string("2 failures") == materialized.Message());
+    EXPECT(1 == CountText(detail, "failure 1/2"));
+    EXPECT(1 == CountText(detail, "first"));
+    EXPECT(1 == CountText(detail, "failures with code=0: 1"));
+    EXPECT(1 == CountText(detail, "failures with code=3: 1"));
+}
+
+const char* filter = nullptr;
+
+void Run(const char* name, void (*test)()) {
+    if (filter && !std::strstr(name, filter)) {
+        return;
+    }
+    const int previous_failure_count = failure_count;
+    test();
+    std::printf("%s %s\n", previous_failure_count == failure_count
+                               ? "[  OK  ]"
+                               : "[ FAIL ]",
+                name);
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    if (argc > 1) {
+        filter = argv[1];
+    }
+
+    Run("wire_round_trip", TestWireRoundTrip);
+    Run("wire_rejects_truncated", TestWireRejectsTruncated);
+    Run("wire_bounds_decoded_sites", TestWireBoundsDecodedSites);
+    Run("fixed_utf8_truncation", TestFixedUtf8Truncation);
+    Run("result_void_propagation", TestResultVoidPropagation);
+    Run("hop_shared_consumers", TestHopSharedConsumers);
+    Run("nested_frames_in_writers", TestNestedFramesInWriters);
+    Run("collector_tally", TestCollectorTally);
+    return 0 == failure_count ? 0 : 1;
+}
@@ -0,0 +1,37 @@
+#!/bin/sh
+# ContextualExceptionTest.cpp 를 빌드 구성별로 빌드해 실행
+# - asan:  ASan/UBSan
+# - fixed: ASan/UBSan, CONTEXTUAL_EXCEPTION_USE_FIXED_CAPACITY
+# - tsan:  TSan (hop 의 여러 소비자 등 스레드 간 공유 검사)
+# 사용 예)
+#   ./RunTests.sh              전체 구성
+#   ./RunTests.sh tsan         지정한 구성만
+# 환경 변수: CXX (기본 g++), CXXFLAGS (기본 -std=c++17 -O1 -g)
+set -e
+
+CXX=${CXX:-g++}
+CXXFLAGS=${CXXFLAGS:--std=c++17 -O1 -g}
+TEST_DIR=$(cd "$(dirname "$0")" && pwd)
+WORK_DIR=$(mktemp -d)
+trap 'rm -rf "$WORK_DIR"' EXIT
+
+# $1: 구성 이름, 나머지: 추가 컴파일 옵션
+run() {
+    name=$1
+    shift
+    echo "== $name"
+    $CXX $CXXFLAGS -Wall -Wextra -Werror -pthread "$@" \
+        "$TEST_DIR/ContextualExceptionTest.cpp" -o "$WORK_DIR/$name"
+    "$WORK_DIR/$name"
+}
+
+SANITIZERS="-fsanitize=address,undefined -fno-sanitize-recover=all"
+for configuration in ${@:-asan fixed tsan}; do
+    case "$configuration" in
+        asan) run asan $SANITIZERS ;;
+        fixed) run fixed $SANITIZERS \
+                   -DCONTEXTUAL_EXCEPTION_USE_FIXED_CAPACITY ;;
+        tsan) run tsan -fsanitize=thread ;;
+        *) echo "unknown configuration: $configuration" >&2; exit 2 ;;
+    esac
+done